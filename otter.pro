@@ -37,6 +37,7 @@ SOURCES += src/main.cpp \
     src/core/BookmarksImporter.cpp \
     src/core/BookmarksManager.cpp \
     src/core/BookmarksModel.cpp \
+    src/core/ClosedWindowsStore.cpp \
     src/core/ContentBlockingList.cpp \
     src/core/ContentBlockingManager.cpp \
     src/core/Console.cpp \
@@ -51,13 +52,18 @@ SOURCES += src/main.cpp \
     src/core/NetworkManagerFactory.cpp \
     src/core/NetworkAutomaticProxy.cpp \
     src/core/NetworkCache.cpp \
+    src/core/NetworkCacheExpirer.cpp \
     src/core/NetworkProxyFactory.cpp \
+    src/core/NetworkTransport.cpp \
     src/core/Notification.cpp \
     src/core/PlatformIntegration.cpp \
+    src/core/PreconnectManager.cpp \
     src/core/SearchesManager.cpp \
     src/core/SearchSuggester.cpp \
     src/core/SessionsManager.cpp \
+    src/core/SessionWriter.cpp \
     src/core/SettingsManager.cpp \
+    src/core/TabHibernationPolicy.cpp \
     src/core/TransfersManager.cpp \
     src/core/Utils.cpp \
     src/core/WebBackend.cpp \
@@ -143,6 +149,7 @@ HEADERS += src/core/Action.h \
     src/core/BookmarksImporter.h \
     src/core/BookmarksManager.h \
     src/core/BookmarksModel.h \
+    src/core/ClosedWindowsStore.h \
     src/core/ContentBlockingList.h \
     src/core/ContentBlockingManager.h \
     src/core/Console.h \
@@ -155,15 +162,20 @@ HEADERS += src/core/Action.h \
     src/core/LocalListingNetworkReply.h \
     src/core/NetworkAutomaticProxy.h \
     src/core/NetworkCache.h \
+    src/core/NetworkCacheExpirer.h \
     src/core/NetworkManager.h \
     src/core/NetworkManagerFactory.h \
     src/core/NetworkProxyFactory.h \
+    src/core/NetworkTransport.h \
     src/core/Notification.h \
     src/core/PlatformIntegration.h \
+    src/core/PreconnectManager.h \
     src/core/SearchesManager.h \
     src/core/SearchSuggester.h \
     src/core/SessionsManager.h \
+    src/core/SessionWriter.h \
     src/core/SettingsManager.h \
+    src/core/TabHibernationPolicy.h \
     src/core/TransfersManager.h \
     src/core/Utils.h \
     src/core/WebBackend.h \
@@ -208,6 +208,7 @@ bool Action::isLocal(int identifier)
 		case Action::ValidateAction:
 		case Action::InspectPageAction:
 		case Action::InspectElementAction:
+		case Action::ExportNetworkLogAction:
 		case Action::WebsitePreferencesAction:
 		case Action::QuickPreferencesAction:
 		case Action::ResetQuickPreferencesAction:
@@ -149,6 +149,7 @@ public:
 		ValidateAction,
 		InspectPageAction,
 		InspectElementAction,
+		ExportNetworkLogAction,
 		WorkOfflineAction,
 		FullScreenAction,
 		ShowMenuBarAction,
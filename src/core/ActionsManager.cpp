@@ -179,6 +179,7 @@ ActionsManagerHelper::ActionsManagerHelper(QObject *parent) : QObject(parent),
 	registerAction(Action::ValidateAction, QT_TRANSLATE_NOOP("actions", "Validate"));
 	registerAction(Action::InspectPageAction, QT_TRANSLATE_NOOP("actions", "Inspect Page"), QString(), QIcon(), true, true, false);
 	registerAction(Action::InspectElementAction, QT_TRANSLATE_NOOP("actions", "Inspect Element..."));
+	registerAction(Action::ExportNetworkLogAction, QT_TRANSLATE_NOOP("actions", "Export Network Log..."));
 	registerAction(Action::WorkOfflineAction, QT_TRANSLATE_NOOP("actions", "Work Offline"), QString(), QIcon(), true, true, false);
 	registerAction(Action::FullScreenAction, QT_TRANSLATE_NOOP("actions", "Full Screen"), QString(), Utils::getIcon(QLatin1String("view-fullscreen")));
 	registerAction(Action::ShowMenuBarAction, QT_TRANSLATE_NOOP("actions", "Show Menubar"), QString(), QIcon(), true, true, true);
@@ -274,7 +275,7 @@ ActionsManagerHelper::ActionsManagerHelper(QObject *parent) : QObject(parent),
 		toolBarDefinitions[toolBar.name] = toolBar;
 	}
 
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString)));
+	SettingsManager::addListener(this, QList<int>() << SettingsManager::Browser_ActionMacrosProfilesOrderOption << SettingsManager::Browser_KeyboardShortcutsProfilesOrderOption);
 }
 
 void ActionsManagerHelper::timerEvent(QTimerEvent *event)
@@ -305,9 +306,11 @@ int ActionsManagerHelper::registerAction(int identifier, const QString &text, co
 	return (actionDefinitions.count() - 1);
 }
 
-void ActionsManagerHelper::optionChanged(const QString &option)
+void ActionsManagerHelper::optionChanged(int identifier, const QVariant &value)
 {
-	if ((option == QLatin1String("Browser/ActionMacrosProfilesOrder") || option == QLatin1String("Browser/KeyboardShortcutsProfilesOrder")) && reloadShortcutsTimer == 0)
+	Q_UNUSED(value)
+
+	if ((identifier == SettingsManager::Browser_ActionMacrosProfilesOrderOption || identifier == SettingsManager::Browser_KeyboardShortcutsProfilesOrderOption) && reloadShortcutsTimer == 0)
 	{
 		reloadShortcutsTimer = startTimer(250);
 	}
@@ -99,7 +99,7 @@ protected:
 	QHash<QString, ToolBarDefinition> toolBarDefinitions;
 
 protected slots:
-	void optionChanged(const QString &option);
+	void optionChanged(int identifier, const QVariant &value);
 
 signals:
 	void shortcutsChanged();
@@ -19,9 +19,11 @@
 
 #include "AddressCompletionModel.h"
 #include "BookmarksManager.h"
+#include "BookmarksModel.h"
 #include "SettingsManager.h"
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QUrl>
 
 namespace Otter
 {
@@ -29,50 +31,371 @@ namespace Otter
 AddressCompletionModel* AddressCompletionModel::m_instance = NULL;
 
 AddressCompletionModel::AddressCompletionModel(QObject *parent) : QAbstractListModel(parent),
-	m_updateTimer(0)
+	m_suggestBookmarks(SettingsManager::getValue(QLatin1String("AddressField/SuggestBookmarks")).toBool())
 {
-	m_updateTimer = startTimer(250);
+	updateCompletion();
 
-	connect(BookmarksManager::getInstance(), SIGNAL(modelModified()), this, SLOT(updateCompletion()));
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString)));
+	BookmarksModel *model = BookmarksManager::getModel();
+
+	connect(model, SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(bookmarksInserted(QModelIndex,int,int)));
+	connect(model, SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)), this, SLOT(bookmarksAboutToBeRemoved(QModelIndex,int,int)));
+	connect(model, SIGNAL(dataChanged(QModelIndex,QModelIndex)), this, SLOT(bookmarksChanged(QModelIndex,QModelIndex)));
+	connect(model, SIGNAL(modelReset()), this, SLOT(updateCompletion()));
+	SettingsManager::addListener(this, QList<int>() << SettingsManager::AddressField_SuggestBookmarksOption);
 }
 
-void AddressCompletionModel::timerEvent(QTimerEvent *event)
+void AddressCompletionModel::optionChanged(int identifier, const QVariant &value)
 {
-	if (event->timerId() == m_updateTimer)
+	if (identifier == SettingsManager::AddressField_SuggestBookmarksOption)
 	{
-		killTimer(m_updateTimer);
+		m_suggestBookmarks = value.toBool();
+
+		updateCompletion();
+	}
+}
 
-		m_updateTimer = 0;
+void AddressCompletionModel::bookmarksInserted(const QModelIndex &parent, int first, int last)
+{
+	if (!m_suggestBookmarks)
+	{
+		return;
+	}
 
-		QStringList urls;
-		urls << QLatin1String("about:bookmarks") << QLatin1String("about:cache") << QLatin1String("about:config") << QLatin1String("about:cookies") << QLatin1String("about:history") << QLatin1String("about:transfers");
-		urls << BookmarksManager::getUrls();
+	QStandardItem *branch = BookmarksManager::getModel()->itemFromIndex(parent);
 
-		beginResetModel();
+	if (!branch)
+	{
+		branch = BookmarksManager::getModel()->invisibleRootItem();
+	}
 
-		m_urls = urls;
+	QStringList urls;
 
-		endResetModel();
+	for (int i = first; i <= last; ++i)
+	{
+		addBookmark(branch->child(i), urls);
 	}
+
+	addUrls(urls);
 }
 
-void AddressCompletionModel::optionChanged(const QString &option)
+void AddressCompletionModel::bookmarksAboutToBeRemoved(const QModelIndex &parent, int first, int last)
 {
-	if (option.contains(QLatin1String("AddressField/Suggest")))
+	if (!m_suggestBookmarks)
 	{
-		updateCompletion();
+		return;
+	}
+
+	QStandardItem *branch = BookmarksManager::getModel()->itemFromIndex(parent);
+
+	if (!branch)
+	{
+		branch = BookmarksManager::getModel()->invisibleRootItem();
+	}
+
+	QStringList urls;
+
+	for (int i = first; i <= last; ++i)
+	{
+		removeBookmark(branch->child(i), urls);
+	}
+
+	removeUrls(urls);
+}
+
+void AddressCompletionModel::bookmarksChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+	if (!m_suggestBookmarks)
+	{
+		return;
+	}
+
+	QStringList addedUrls;
+	QStringList removedUrls;
+
+	for (int i = topLeft.row(); i <= bottomRight.row(); ++i)
+	{
+		QStandardItem *bookmark = BookmarksManager::getModel()->itemFromIndex(topLeft.sibling(i, 0));
+
+		if (!bookmark || static_cast<BookmarksItem::BookmarkType>(bookmark->data(BookmarksModel::TypeRole).toInt()) != BookmarksItem::UrlBookmark)
+		{
+			continue;
+		}
+
+		const QString url = bookmark->data(BookmarksModel::UrlRole).toUrl().toString();
+
+		if (m_bookmarks.value(bookmark) != url)
+		{
+			if (m_bookmarks.contains(bookmark))
+			{
+				removedUrls.append(m_bookmarks.take(bookmark));
+			}
+
+			if (!url.isEmpty())
+			{
+				m_bookmarks[bookmark] = url;
+
+				addedUrls.append(url);
+			}
+		}
 	}
+
+	removeUrls(removedUrls);
+	addUrls(addedUrls);
 }
 
 void AddressCompletionModel::updateCompletion()
 {
-	if (m_updateTimer == 0)
+	QStringList urls;
+	urls << QLatin1String("about:bookmarks") << QLatin1String("about:cache") << QLatin1String("about:config") << QLatin1String("about:cookies") << QLatin1String("about:history") << QLatin1String("about:transfers");
+
+	m_bookmarks.clear();
+
+	if (m_suggestBookmarks)
+	{
+		QList<QStandardItem*> branches;
+		branches.append(BookmarksManager::getModel()->invisibleRootItem());
+
+		while (!branches.isEmpty())
+		{
+			QStandardItem *branch = branches.takeLast();
+
+			for (int i = 0; i < branch->rowCount(); ++i)
+			{
+				QStandardItem *bookmark = branch->child(i);
+
+				if (!bookmark)
+				{
+					continue;
+				}
+
+				if (bookmark->hasChildren())
+				{
+					branches.append(bookmark);
+				}
+
+				const QString url = bookmark->data(BookmarksModel::UrlRole).toUrl().toString();
+
+				if (!url.isEmpty() && static_cast<BookmarksItem::BookmarkType>(bookmark->data(BookmarksModel::TypeRole).toInt()) == BookmarksItem::UrlBookmark)
+				{
+					m_bookmarks[bookmark] = url;
+
+					urls.append(url);
+				}
+			}
+		}
+	}
+
+	beginResetModel();
+
+	m_completions.clear();
+	m_urls.clear();
+
+	for (int i = 0; i < urls.count(); ++i)
+	{
+		const QStringList completions = getCompletions(urls.at(i));
+
+		for (int j = 0; j < completions.count(); ++j)
+		{
+			if (!m_urls.contains(completions.at(j)))
+			{
+				m_completions.append(completions.at(j));
+			}
+
+			m_urls[completions.at(j)].append(urls.at(i));
+		}
+	}
+
+	qSort(m_completions.begin(), m_completions.end(), completionOrder);
+
+	endResetModel();
+}
+
+void AddressCompletionModel::addCompletion(const QString &completion, const QString &url)
+{
+	if (m_urls.contains(completion))
+	{
+		m_urls[completion].append(url);
+
+		return;
+	}
+
+	const int row = (qLowerBound(m_completions.begin(), m_completions.end(), completion, completionOrder) - m_completions.begin());
+
+	beginInsertRows(QModelIndex(), row, row);
+
+	m_completions.insert(row, completion);
+	m_urls[completion].append(url);
+
+	endInsertRows();
+}
+
+void AddressCompletionModel::removeCompletion(const QString &completion, const QString &url)
+{
+	if (!m_urls.contains(completion))
+	{
+		return;
+	}
+
+	QStringList &urls = m_urls[completion];
+	urls.removeOne(url);
+
+	if (!urls.isEmpty())
+	{
+		return;
+	}
+
+	m_urls.remove(completion);
+
+	QStringList::iterator iterator = qLowerBound(m_completions.begin(), m_completions.end(), completion, completionOrder);
+
+	while (iterator != m_completions.end() && *iterator != completion && !completionOrder(completion, *iterator))
+	{
+		++iterator;
+	}
+
+	if (iterator == m_completions.end() || *iterator != completion)
+	{
+		return;
+	}
+
+	const int row = (iterator - m_completions.begin());
+
+	beginRemoveRows(QModelIndex(), row, row);
+
+	m_completions.removeAt(row);
+
+	endRemoveRows();
+}
+
+void AddressCompletionModel::addBookmark(QStandardItem *bookmark, QStringList &urls)
+{
+	if (!bookmark)
+	{
+		return;
+	}
+
+	for (int i = 0; i < bookmark->rowCount(); ++i)
+	{
+		addBookmark(bookmark->child(i), urls);
+	}
+
+	const QString url = bookmark->data(BookmarksModel::UrlRole).toUrl().toString();
+
+	if (!url.isEmpty() && !m_bookmarks.contains(bookmark) && static_cast<BookmarksItem::BookmarkType>(bookmark->data(BookmarksModel::TypeRole).toInt()) == BookmarksItem::UrlBookmark)
+	{
+		m_bookmarks[bookmark] = url;
+
+		urls.append(url);
+	}
+}
+
+void AddressCompletionModel::removeBookmark(QStandardItem *bookmark, QStringList &urls)
+{
+	if (!bookmark)
+	{
+		return;
+	}
+
+	for (int i = 0; i < bookmark->rowCount(); ++i)
+	{
+		removeBookmark(bookmark->child(i), urls);
+	}
+
+	if (m_bookmarks.contains(bookmark))
 	{
-		m_updateTimer = startTimer(250);
+		urls.append(m_bookmarks.take(bookmark));
 	}
 }
 
+void AddressCompletionModel::addUrls(const QStringList &urls)
+{
+	if (urls.count() < 10)
+	{
+		for (int i = 0; i < urls.count(); ++i)
+		{
+			const QStringList completions = getCompletions(urls.at(i));
+
+			for (int j = 0; j < completions.count(); ++j)
+			{
+				addCompletion(completions.at(j), urls.at(i));
+			}
+		}
+
+		return;
+	}
+
+	beginResetModel();
+
+	for (int i = 0; i < urls.count(); ++i)
+	{
+		const QStringList completions = getCompletions(urls.at(i));
+
+		for (int j = 0; j < completions.count(); ++j)
+		{
+			if (!m_urls.contains(completions.at(j)))
+			{
+				m_completions.append(completions.at(j));
+			}
+
+			m_urls[completions.at(j)].append(urls.at(i));
+		}
+	}
+
+	qSort(m_completions.begin(), m_completions.end(), completionOrder);
+
+	endResetModel();
+}
+
+void AddressCompletionModel::removeUrls(const QStringList &urls)
+{
+	if (urls.count() < 10)
+	{
+		for (int i = 0; i < urls.count(); ++i)
+		{
+			const QStringList completions = getCompletions(urls.at(i));
+
+			for (int j = 0; j < completions.count(); ++j)
+			{
+				removeCompletion(completions.at(j), urls.at(i));
+			}
+		}
+
+		return;
+	}
+
+	beginResetModel();
+
+	for (int i = 0; i < urls.count(); ++i)
+	{
+		const QStringList completions = getCompletions(urls.at(i));
+
+		for (int j = 0; j < completions.count(); ++j)
+		{
+			const QHash<QString, QStringList>::iterator iterator = m_urls.find(completions.at(j));
+
+			if (iterator != m_urls.end())
+			{
+				iterator.value().removeOne(urls.at(i));
+
+				if (iterator.value().isEmpty())
+				{
+					m_urls.erase(iterator);
+				}
+			}
+		}
+	}
+
+	for (int i = (m_completions.count() - 1); i >= 0; --i)
+	{
+		if (!m_urls.contains(m_completions.at(i)))
+		{
+			m_completions.removeAt(i);
+		}
+	}
+
+	endResetModel();
+}
+
 AddressCompletionModel* AddressCompletionModel::getInstance()
 {
 	if (!m_instance)
@@ -83,11 +406,36 @@ AddressCompletionModel* AddressCompletionModel::getInstance()
 	return m_instance;
 }
 
+QStringList AddressCompletionModel::getCompletions(const QString &url)
+{
+	QStringList completions(url);
+	const int schemeEnd = url.indexOf(QLatin1String("://"));
+
+	if (schemeEnd > 0)
+	{
+		QString completion = url.mid(schemeEnd + 3);
+
+		completions.append(completion);
+
+		if (completion.startsWith(QLatin1String("www."), Qt::CaseInsensitive))
+		{
+			completions.append(completion.mid(4));
+		}
+	}
+
+	return completions;
+}
+
 QVariant AddressCompletionModel::data(const QModelIndex &index, int role) const
 {
-	if (role == Qt::DisplayRole && index.column() == 0 && index.row() >= 0 && index.row() < m_urls.count())
+	if (role == Qt::DisplayRole && index.column() == 0 && index.row() >= 0 && index.row() < m_completions.count())
 	{
-		return m_urls.at(index.row());
+		return m_completions.at(index.row());
+	}
+
+	if (role == Qt::UserRole && index.column() == 0 && index.row() >= 0 && index.row() < m_completions.count())
+	{
+		return QUrl(m_urls.value(m_completions.at(index.row())).value(0));
 	}
 
 	return QVariant();
@@ -104,7 +452,12 @@ QVariant AddressCompletionModel::headerData(int section, Qt::Orientation orienta
 
 int AddressCompletionModel::rowCount(const QModelIndex &index) const
 {
-	return (index.isValid() ? 0 : m_urls.count());
+	return (index.isValid() ? 0 : m_completions.count());
+}
+
+bool AddressCompletionModel::completionOrder(const QString &first, const QString &second)
+{
+	return (QString::compare(first, second, Qt::CaseInsensitive) < 0);
 }
 
 }
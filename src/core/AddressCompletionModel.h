@@ -21,6 +21,8 @@
 #define OTTER_ADDRESSCOMPLETIONMODEL_H
 
 #include <QtCore/QAbstractListModel>
+#include <QtCore/QStringList>
+#include <QtGui/QStandardItem>
 
 namespace Otter
 {
@@ -36,17 +38,29 @@ public:
 	int rowCount(const QModelIndex &index = QModelIndex()) const;
 
 protected:
-	void timerEvent(QTimerEvent *event);
+	void addCompletion(const QString &completion, const QString &url);
+	void removeCompletion(const QString &completion, const QString &url);
+	void addBookmark(QStandardItem *bookmark, QStringList &urls);
+	void removeBookmark(QStandardItem *bookmark, QStringList &urls);
+	void addUrls(const QStringList &urls);
+	void removeUrls(const QStringList &urls);
+	static QStringList getCompletions(const QString &url);
+	static bool completionOrder(const QString &first, const QString &second);
 
 protected slots:
-	void optionChanged(const QString &option);
+	void optionChanged(int identifier, const QVariant &value);
+	void bookmarksInserted(const QModelIndex &parent, int first, int last);
+	void bookmarksAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+	void bookmarksChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
 	void updateCompletion();
 
 private:
 	explicit AddressCompletionModel(QObject *parent = NULL);
 
-	QStringList m_urls;
-	int m_updateTimer;
+	QStringList m_completions;
+	QHash<QString, QStringList> m_urls;
+	QHash<QStandardItem*, QString> m_bookmarks;
+	bool m_suggestBookmarks;
 
 	static AddressCompletionModel *m_instance;
 };
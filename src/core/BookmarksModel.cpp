@@ -28,6 +28,7 @@ namespace Otter
 {
 
 QHash<QString, QList<BookmarksItem*> > BookmarksItem::m_urls;
+QHash<QString, QList<BookmarksItem*> > BookmarksItem::m_hosts;
 QHash<QString, BookmarksItem*> BookmarksItem::m_keywords;
 
 BookmarksItem::BookmarksItem(BookmarkType type, const QUrl &url, const QString &title) : QStandardItem()
@@ -68,6 +69,18 @@ BookmarksItem::~BookmarksItem()
 				m_urls.remove(url);
 			}
 		}
+
+		const QString host = getHostKey(data(BookmarksModel::UrlRole).toUrl());
+
+		if (m_hosts.contains(host))
+		{
+			m_hosts[host].removeAll(this);
+
+			if (m_hosts[host].isEmpty())
+			{
+				m_hosts.remove(host);
+			}
+		}
 	}
 
 	if (!data(BookmarksModel::KeywordRole).toString().isEmpty() && m_keywords.contains(data(BookmarksModel::UrlRole).toString()))
@@ -91,6 +104,15 @@ void BookmarksItem::setData(const QVariant &value, int role)
 			{
 				m_urls.remove(oldUrl);
 			}
+
+			const QString oldHost = getHostKey(data(BookmarksModel::UrlRole).toUrl());
+
+			m_hosts[oldHost].removeAll(this);
+
+			if (m_hosts[oldHost].isEmpty())
+			{
+				m_hosts.remove(oldHost);
+			}
 		}
 
 		if (!newUrl.isEmpty())
@@ -101,6 +123,7 @@ void BookmarksItem::setData(const QVariant &value, int role)
 			}
 
 			m_urls[newUrl].append(this);
+			m_hosts[getHostKey(value.toUrl())].append(this);
 		}
 	}
 	else if (role == BookmarksModel::KeywordRole && value.toString() != data(BookmarksModel::KeywordRole).toString())
@@ -122,6 +145,16 @@ void BookmarksItem::setData(const QVariant &value, int role)
 	QStandardItem::setData(value, role);
 }
 
+QString BookmarksItem::getHostKey(const QUrl &url)
+{
+	if (url.host().isEmpty())
+	{
+		return url.toString(QUrl::RemoveQuery | QUrl::RemoveFragment);
+	}
+
+	return url.host();
+}
+
 QStandardItem* BookmarksItem::clone() const
 {
 	BookmarksItem *item = new BookmarksItem(static_cast<BookmarkType>(data(BookmarksModel::TypeRole).toInt()), data(BookmarksModel::UrlRole).toUrl(), data(BookmarksModel::TitleRole).toString());
@@ -215,6 +248,25 @@ BookmarksModel::BookmarksModel(QObject *parent) : QStandardItemModel(parent)
 	appendRow(new BookmarksItem(BookmarksItem::RootBookmark, QUrl(), tr("Bookmarks")));
 	appendRow(new BookmarksItem(BookmarksItem::TrashBookmark, QUrl(), tr("Trash")));
 	setItemPrototype(new BookmarksItem(BookmarksItem::UnknownBookmark));
+
+	const QStringList backends = WebBackendsManager::getBackends();
+
+	for (int i = 0; i < backends.count(); ++i)
+	{
+		connect(WebBackendsManager::getBackend(backends.at(i)), SIGNAL(iconChanged(QUrl)), this, SLOT(notifyIconChanged(QUrl)));
+	}
+}
+
+void BookmarksModel::notifyIconChanged(const QUrl &url)
+{
+	const QList<BookmarksItem*> bookmarks = BookmarksItem::m_hosts.value(BookmarksItem::getHostKey(url));
+
+	for (int i = 0; i < bookmarks.count(); ++i)
+	{
+		const QModelIndex index = bookmarks.at(i)->index();
+
+		emit dataChanged(index, index);
+	}
 }
 
 QMimeData* BookmarksModel::mimeData(const QModelIndexList &indexes) const
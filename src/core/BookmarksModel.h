@@ -52,6 +52,7 @@ protected:
 	static QList<BookmarksItem*> getBookmarks(const QString &url);
 	static QStringList getKeywords();
 	static QStringList getUrls();
+	static QString getHostKey(const QUrl &url);
 	static BookmarksItem* getBookmark(const QString &keyword);
 	static bool hasBookmark(const QString &url);
 	static bool hasKeyword(const QString &keyword);
@@ -59,9 +60,11 @@ protected:
 
 private:
 	static QHash<QString, QList<BookmarksItem*> > m_urls;
+	static QHash<QString, QList<BookmarksItem*> > m_hosts;
 	static QHash<QString, BookmarksItem*> m_keywords;
 
 	friend class BookmarksManager;
+	friend class BookmarksModel;
 	friend class BookmarkPropertiesDialog;
 };
 
@@ -91,6 +94,9 @@ public:
 	QStringList mimeTypes() const;
 	QList<QStandardItem*> findUrls(const QString &url, QStandardItem *branch = NULL);
 	bool dropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent);
+
+protected slots:
+	void notifyIconChanged(const QUrl &url);
 };
 
 }
@@ -0,0 +1,287 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2013 - 2014 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "ClosedWindowsStore.h"
+#include "SessionWriter.h"
+#include "SettingsManager.h"
+
+#include <QtCore/QDir>
+
+namespace Otter
+{
+
+ClosedWindowsStore::ClosedWindowsStore() : m_file(NULL),
+	m_wastedBytes(0),
+	m_memoryLimit(qMax(0, SettingsManager::getValue(SettingsManager::History_ClosedWindowsMemoryLimitAmountOption).toInt())),
+	m_limit(qMax(0, SettingsManager::getValue(SettingsManager::History_ClosedWindowsLimitAmountOption).toInt()))
+{
+}
+
+ClosedWindowsStore::~ClosedWindowsStore()
+{
+	delete m_file;
+}
+
+void ClosedWindowsStore::addWindow(const SessionMainWindow &window)
+{
+	ClosedWindowEntry entry;
+	entry.information.title = window.windows.value(window.index, SessionWindow()).getTitle();
+	entry.information.url = window.windows.value(window.index, SessionWindow()).getUrl();
+
+	QDataStream stream(&entry.data, QIODevice::WriteOnly);
+	stream.setVersion(QDataStream::Qt_5_2);
+	stream << window.geometry << window.state << qint32(window.index) << qint32(window.windows.count());
+
+	for (int i = 0; i < window.windows.count(); ++i)
+	{
+		SessionWriter::writeSessionWindow(stream, window.windows.at(i));
+	}
+
+	addEntry(entry);
+}
+
+void ClosedWindowsStore::addWindow(const SessionWindow &window)
+{
+	ClosedWindowEntry entry;
+	entry.information.title = window.getTitle();
+	entry.information.url = window.getUrl();
+
+	QDataStream stream(&entry.data, QIODevice::WriteOnly);
+	stream.setVersion(QDataStream::Qt_5_2);
+
+	SessionWriter::writeSessionWindow(stream, window);
+
+	addEntry(entry);
+}
+
+void ClosedWindowsStore::addEntry(const ClosedWindowEntry &entry)
+{
+	m_entries.prepend(entry);
+
+	++m_urls[entry.information.url];
+
+	while (m_entries.count() > m_limit)
+	{
+		removeEntry(m_entries.count() - 1);
+	}
+
+	if (m_entries.count() <= m_memoryLimit || SessionsManager::isPrivate())
+	{
+		return;
+	}
+
+	ClosedWindowEntry &spilledEntry = m_entries[m_memoryLimit];
+
+	if (!m_file && !SessionsManager::isPrivate() && !SessionsManager::getCachePath().isEmpty())
+	{
+		QDir().mkpath(SessionsManager::getCachePath());
+
+		m_file = new QTemporaryFile(SessionsManager::getCachePath() + QLatin1String("/closedWindows-XXXXXX.dat"));
+
+		if (!m_file->open())
+		{
+			delete m_file;
+
+			m_file = NULL;
+		}
+	}
+
+	if (!m_file || !m_file->seek(m_file->size()) || m_file->write(spilledEntry.data) != spilledEntry.data.size())
+	{
+		return;
+	}
+
+	spilledEntry.offset = (m_file->size() - spilledEntry.data.size());
+	spilledEntry.size = spilledEntry.data.size();
+	spilledEntry.data = QByteArray();
+
+	if (m_wastedBytes > 1048576 && m_wastedBytes > (m_file->size() / 2))
+	{
+		compact();
+	}
+}
+
+void ClosedWindowsStore::removeWindow(int index)
+{
+	if (index >= 0 && index < m_entries.count())
+	{
+		removeEntry(index);
+	}
+}
+
+void ClosedWindowsStore::removeEntry(int index)
+{
+	const QString url = m_entries.at(index).information.url;
+
+	if (--m_urls[url] <= 0)
+	{
+		m_urls.remove(url);
+	}
+
+	m_wastedBytes += m_entries.at(index).size;
+
+	m_entries.removeAt(index);
+}
+
+void ClosedWindowsStore::clear()
+{
+	m_entries.clear();
+	m_urls.clear();
+
+	delete m_file;
+
+	m_file = NULL;
+	m_wastedBytes = 0;
+}
+
+void ClosedWindowsStore::compact()
+{
+	for (int i = 0; i < m_entries.count(); ++i)
+	{
+		if (m_entries.at(i).offset >= 0)
+		{
+			m_entries[i].data = getData(i);
+			m_entries[i].offset = -1;
+			m_entries[i].size = 0;
+		}
+	}
+
+	m_file->resize(0);
+
+	m_wastedBytes = 0;
+
+	for (int i = m_memoryLimit; i < m_entries.count(); ++i)
+	{
+		const qint64 offset = m_file->size();
+
+		if (m_file->seek(offset) && m_file->write(m_entries.at(i).data) == m_entries.at(i).data.size())
+		{
+			m_entries[i].offset = offset;
+			m_entries[i].size = m_entries.at(i).data.size();
+			m_entries[i].data = QByteArray();
+		}
+	}
+}
+
+SessionMainWindow ClosedWindowsStore::getMainWindow(int index)
+{
+	SessionMainWindow window;
+	QByteArray data = getData(index);
+	QDataStream stream(&data, QIODevice::ReadOnly);
+	stream.setVersion(QDataStream::Qt_5_2);
+
+	qint32 windowIndex;
+	qint32 amount;
+
+	stream >> window.geometry >> window.state >> windowIndex >> amount;
+
+	window.index = windowIndex;
+
+	for (qint32 i = 0; i < amount; ++i)
+	{
+		const SessionWindow tab = SessionsManager::readSessionWindow(stream);
+
+		if (stream.status() != QDataStream::Ok)
+		{
+			break;
+		}
+
+		window.windows.append(tab);
+	}
+
+	return window;
+}
+
+SessionWindow ClosedWindowsStore::getWindow(int index)
+{
+	QByteArray data = getData(index);
+	QDataStream stream(&data, QIODevice::ReadOnly);
+	stream.setVersion(QDataStream::Qt_5_2);
+
+	return (data.isEmpty() ? SessionWindow() : SessionsManager::readSessionWindow(stream));
+}
+
+QByteArray ClosedWindowsStore::getData(int index)
+{
+	if (index < 0 || index >= m_entries.count())
+	{
+		return QByteArray();
+	}
+
+	const ClosedWindowEntry &entry = m_entries.at(index);
+
+	if (entry.offset < 0)
+	{
+		return entry.data;
+	}
+
+	if (!m_file || !m_file->seek(entry.offset))
+	{
+		return QByteArray();
+	}
+
+	return m_file->read(entry.size);
+}
+
+ClosedWindow ClosedWindowsStore::getInformation(int index) const
+{
+	return ((index >= 0 && index < m_entries.count()) ? m_entries.at(index).information : ClosedWindow());
+}
+
+QList<ClosedWindow> ClosedWindowsStore::getInformation() const
+{
+	QList<ClosedWindow> information;
+
+	for (int i = 0; i < m_entries.count(); ++i)
+	{
+		information.append(m_entries.at(i).information);
+	}
+
+	return information;
+}
+
+int ClosedWindowsStore::findUrl(const QString &url) const
+{
+	if (!m_urls.contains(url))
+	{
+		return -1;
+	}
+
+	for (int i = (m_entries.count() - 1); i >= 0; --i)
+	{
+		if (m_entries.at(i).information.url == url)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+int ClosedWindowsStore::getCount() const
+{
+	return m_entries.count();
+}
+
+bool ClosedWindowsStore::isEmpty() const
+{
+	return m_entries.isEmpty();
+}
+
+}
@@ -0,0 +1,83 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2013 - 2014 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_CLOSEDWINDOWSSTORE_H
+#define OTTER_CLOSEDWINDOWSSTORE_H
+
+#include "SessionsManager.h"
+
+#include <QtCore/QTemporaryFile>
+
+namespace Otter
+{
+
+struct ClosedWindow
+{
+	QString title;
+	QString url;
+};
+
+class ClosedWindowsStore
+{
+public:
+	ClosedWindowsStore();
+	~ClosedWindowsStore();
+
+	void addWindow(const SessionMainWindow &window);
+	void addWindow(const SessionWindow &window);
+	void removeWindow(int index);
+	void clear();
+	SessionMainWindow getMainWindow(int index);
+	SessionWindow getWindow(int index);
+	ClosedWindow getInformation(int index) const;
+	QList<ClosedWindow> getInformation() const;
+	int findUrl(const QString &url) const;
+	int getCount() const;
+	bool isEmpty() const;
+
+protected:
+	struct ClosedWindowEntry
+	{
+		ClosedWindow information;
+		QByteArray data;
+		qint64 offset;
+		qint64 size;
+
+		ClosedWindowEntry() : offset(-1), size(0) {}
+	};
+
+	void addEntry(const ClosedWindowEntry &entry);
+	void removeEntry(int index);
+	void compact();
+	QByteArray getData(int index);
+
+private:
+	Q_DISABLE_COPY(ClosedWindowsStore)
+
+	QTemporaryFile *m_file;
+	QList<ClosedWindowEntry> m_entries;
+	QHash<QString, int> m_urls;
+	qint64 m_wastedBytes;
+	int m_memoryLimit;
+	int m_limit;
+};
+
+}
+
+#endif
@@ -21,6 +21,7 @@
 #include "SessionsManager.h"
 #include "SettingsManager.h"
 
+#include <QtCore/QDateTime>
 #include <QtCore/QFile>
 #include <QtCore/QSaveFile>
 #include <QtCore/QTimerEvent>
@@ -32,7 +33,11 @@ CookieJar::CookieJar(bool isPrivate, QObject *parent) : QNetworkCookieJar(parent
 	m_keepCookiesPolicy(UntilExpireKeepCookies),
 	m_thirdPartyCookiesAcceptPolicy(AlwaysAcceptCookies),
 	m_saveTimer(0),
+	m_journalRecords(0),
+	m_cookiesAmount(0),
+	m_references(0),
 	m_enableCookies(true),
+	m_isLoaded(isPrivate),
 	m_isPrivate(isPrivate)
 {
 	if (isPrivate)
@@ -40,55 +45,141 @@ CookieJar::CookieJar(bool isPrivate, QObject *parent) : QNetworkCookieJar(parent
 		return;
 	}
 
-	QFile file(SessionsManager::getProfilePath() + QLatin1String("/cookies.dat"));
+	optionChanged(SettingsManager::Browser_EnableCookiesOption, SettingsManager::getValue(SettingsManager::Browser_EnableCookiesOption));
+
+	SettingsManager::addListener(this, QList<int>() << SettingsManager::Browser_EnableCookiesOption << SettingsManager::Browser_PrivateModeOption);
+}
+
+CookieJar::~CookieJar()
+{
+	if (m_saveTimer != 0)
+	{
+		killTimer(m_saveTimer);
+
+		m_saveTimer = 0;
 
-	if (!file.open(QIODevice::ReadOnly))
+		saveJournal();
+	}
+}
+
+void CookieJar::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() != m_saveTimer)
 	{
 		return;
 	}
 
-	QList<QNetworkCookie> allCookies;
-	QDataStream stream(&file);
-	quint32 amount;
+	killTimer(m_saveTimer);
 
-	stream >> amount;
+	m_saveTimer = 0;
 
-	for (quint32 i = 0; i < amount; ++i)
+	if (m_journalRecords > 1000 && m_journalRecords > m_cookiesAmount)
 	{
-		QByteArray value;
+		saveCookies();
+	}
+	else
+	{
+		saveJournal();
+	}
+}
 
-		stream >> value;
+void CookieJar::scheduleSave()
+{
+	if (!m_isPrivate && m_saveTimer == 0)
+	{
+		m_saveTimer = startTimer(500);
+	}
+}
+
+void CookieJar::load()
+{
+	if (m_isLoaded)
+	{
+		return;
+	}
 
-		const QList<QNetworkCookie> cookies = QNetworkCookie::parseCookies(value);
+	m_isLoaded = true;
 
-		for (int j = 0; j < cookies.count(); ++j)
-		{
-			allCookies.append(cookies.at(j));
-		}
+	setCookies(QList<QNetworkCookie>());
+
+	QFile file(SessionsManager::getProfilePath() + QLatin1String("/cookies.dat"));
+
+	if (file.open(QIODevice::ReadOnly))
+	{
+		QDataStream stream(&file);
+		quint32 amount;
+
+		stream >> amount;
 
-		if (stream.atEnd())
+		for (quint32 i = 0; i < amount; ++i)
 		{
-			break;
+			QByteArray value;
+
+			stream >> value;
+
+			const QList<QNetworkCookie> cookies = QNetworkCookie::parseCookies(value);
+
+			for (int j = 0; j < cookies.count(); ++j)
+			{
+				indexCookie(cookies.at(j));
+			}
+
+			if (stream.atEnd())
+			{
+				break;
+			}
 		}
+
+		file.close();
 	}
 
-	optionChanged(QLatin1String("Browser/EnableCookies"), SettingsManager::getValue(QLatin1String("Browser/EnableCookies")));
-	setAllCookies(allCookies);
+	QFile journalFile(SessionsManager::getProfilePath() + QLatin1String("/cookies.journal"));
 
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString,QVariant)));
+	if (journalFile.open(QIODevice::ReadOnly))
+	{
+		QDataStream stream(&journalFile);
+		stream.setVersion(QDataStream::Qt_5_2);
+
+		while (!stream.atEnd())
+		{
+			quint8 type;
+			QByteArray value;
+
+			stream >> type >> value;
+
+			if (stream.status() != QDataStream::Ok)
+			{
+				break;
+			}
+
+			const QList<QNetworkCookie> cookies = QNetworkCookie::parseCookies(value);
+
+			for (int i = 0; i < cookies.count(); ++i)
+			{
+				if (type == InsertCookieRecord)
+				{
+					indexCookie(cookies.at(i));
+				}
+				else
+				{
+					unindexCookie(cookies.at(i));
+				}
+			}
+
+			++m_journalRecords;
+		}
+
+		journalFile.close();
+	}
 }
 
-void CookieJar::timerEvent(QTimerEvent *event)
+void CookieJar::saveCookies()
 {
-	if (event->timerId() != m_saveTimer)
+	if (m_isPrivate)
 	{
 		return;
 	}
 
-	killTimer(m_saveTimer);
-
-	m_saveTimer = 0;
-
 	QSaveFile file(SessionsManager::getProfilePath() + QLatin1String("/cookies.dat"));
 
 	if (!file.open(QIODevice::WriteOnly))
@@ -96,7 +187,7 @@ void CookieJar::timerEvent(QTimerEvent *event)
 		return;
 	}
 
-	QList<QNetworkCookie> cookies = allCookies();
+	const QList<QNetworkCookie> cookies = getCookies();
 	QDataStream stream(&file);
 	stream << quint32(cookies.size());
 
@@ -105,24 +196,70 @@ void CookieJar::timerEvent(QTimerEvent *event)
 		stream << cookies.at(i).toRawForm();
 	}
 
-	file.commit();
+	if (file.commit())
+	{
+		QFile::remove(SessionsManager::getProfilePath() + QLatin1String("/cookies.journal"));
+
+		m_pendingRecords.clear();
+		m_journalRecords = 0;
+	}
 }
 
-void CookieJar::scheduleSave()
+void CookieJar::saveJournal()
 {
-	if (!m_isPrivate && m_saveTimer == 0)
+	if (m_pendingRecords.isEmpty())
 	{
-		m_saveTimer = startTimer(500);
+		return;
+	}
+
+	QFile file(SessionsManager::getProfilePath() + QLatin1String("/cookies.journal"));
+
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
+	{
+		return;
+	}
+
+	file.write(m_pendingRecords);
+	file.close();
+
+	m_pendingRecords.clear();
+}
+
+void CookieJar::addRecord(CookieRecordType type, const QNetworkCookie &cookie)
+{
+	if (m_isPrivate)
+	{
+		return;
+	}
+
+	QDataStream stream(&m_pendingRecords, QIODevice::WriteOnly | QIODevice::Append);
+	stream.setVersion(QDataStream::Qt_5_2);
+	stream << quint8(type) << cookie.toRawForm();
+
+	++m_journalRecords;
+
+	scheduleSave();
+}
+
+void CookieJar::setCookies(const QList<QNetworkCookie> &cookies)
+{
+	m_cookies.clear();
+
+	m_cookiesAmount = 0;
+
+	for (int i = 0; i < cookies.count(); ++i)
+	{
+		indexCookie(cookies.at(i));
 	}
 }
 
-void CookieJar::optionChanged(const QString &option, const QVariant &value)
+void CookieJar::optionChanged(int identifier, const QVariant &value)
 {
-	if (option == QLatin1String("Browser/PrivateMode"))
+	if (identifier == SettingsManager::Browser_PrivateModeOption)
 	{
 		m_enableCookies = (!value.toBool() && SettingsManager::getValue(QLatin1String("Browser/EnableCookies")).toBool());
 	}
-	else if (option == QLatin1String("Browser/EnableCookies"))
+	else if (identifier == SettingsManager::Browser_EnableCookiesOption)
 	{
 		m_enableCookies = (value.toBool() && !SettingsManager::getValue(QLatin1String("Browser/PrivateMode")).toBool());
 	}
@@ -132,16 +269,43 @@ void CookieJar::clearCookies(int period)
 {
 	Q_UNUSED(period)
 
-	setAllCookies(QList<QNetworkCookie>());
-	scheduleSave();
+	m_isLoaded = true;
+
+	setCookies(QList<QNetworkCookie>());
+	saveCookies();
 }
 
-CookieJar* CookieJar::clone(QObject *parent)
+void CookieJar::ref()
 {
-	CookieJar *cookieJar = new CookieJar(m_isPrivate, parent);
-	cookieJar->setAllCookies(allCookies());
+	++m_references;
+}
 
-	return cookieJar;
+bool CookieJar::deref()
+{
+	--m_references;
+
+	return (m_references > 0);
+}
+
+QString CookieJar::getDomainKey(const QString &domain)
+{
+	const QString host = (domain.startsWith(QLatin1Char('.')) ? domain.mid(1) : domain).toLower();
+	QUrl url;
+	url.setHost(host);
+
+	const QString topLevelDomain = url.topLevelDomain();
+
+	if (topLevelDomain.isEmpty())
+	{
+		return host.section(QLatin1Char('.'), -2);
+	}
+
+	if (topLevelDomain.length() >= host.length())
+	{
+		return host;
+	}
+
+	return (host.left(host.length() - topLevelDomain.length()).section(QLatin1Char('.'), -1) + topLevelDomain);
 }
 
 QList<QNetworkCookie> CookieJar::cookiesForUrl(const QUrl &url) const
@@ -151,14 +315,41 @@ QList<QNetworkCookie> CookieJar::cookiesForUrl(const QUrl &url) const
 		return QList<QNetworkCookie>();
 	}
 
-	return QNetworkCookieJar::cookiesForUrl(url);
+	const_cast<CookieJar*>(this)->load();
+
+	const QString host = url.host();
+	const QList<QNetworkCookie> cookies = m_cookies.value(getDomainKey(host));
+	const QDateTime currentDateTime = QDateTime::currentDateTimeUtc();
+	const bool isEncrypted = (url.scheme().toLower() == QLatin1String("https"));
+	QList<QNetworkCookie> urlCookies;
+
+	for (int i = 0; i < cookies.count(); ++i)
+	{
+		if (!isParentDomain(host, cookies.at(i).domain()) || !isParentPath(url.path(), cookies.at(i).path()) || (!cookies.at(i).isSessionCookie() && cookies.at(i).expirationDate() < currentDateTime) || (cookies.at(i).isSecure() && !isEncrypted))
+		{
+			continue;
+		}
+
+		int position = 0;
+
+		while (position < urlCookies.count() && urlCookies.at(position).path().length() >= cookies.at(i).path().length())
+		{
+			++position;
+		}
+
+		urlCookies.insert(position, cookies.at(i));
+	}
+
+	return urlCookies;
 }
 
 QList<QNetworkCookie> CookieJar::getCookies(const QString &domain) const
 {
+	const_cast<CookieJar*>(this)->load();
+
 	if (!domain.isEmpty())
 	{
-		const QList<QNetworkCookie> cookies = allCookies();
+		const QList<QNetworkCookie> cookies = m_cookies.value(getDomainKey(domain));
 		QList<QNetworkCookie> domainCookies;
 
 		for (int i = 0; i < cookies.length(); ++i)
@@ -172,7 +363,15 @@ QList<QNetworkCookie> CookieJar::getCookies(const QString &domain) const
 		return domainCookies;
 	}
 
-	return allCookies();
+	QList<QNetworkCookie> cookies;
+	QHash<QString, QList<QNetworkCookie> >::const_iterator iterator;
+
+	for (iterator = m_cookies.constBegin(); iterator != m_cookies.constEnd(); ++iterator)
+	{
+		cookies.append(iterator.value());
+	}
+
+	return cookies;
 }
 
 CookieJar::KeepCookiesPolicy CookieJar::getKeepCookiesPolicy() const
@@ -192,30 +391,41 @@ bool CookieJar::insertCookie(const QNetworkCookie &cookie)
 		return false;
 	}
 
-	const bool result = QNetworkCookieJar::insertCookie(cookie);
+	load();
 
-	if (result)
+	if (!cookie.isSessionCookie() && cookie.expirationDate() < QDateTime::currentDateTimeUtc())
 	{
-		scheduleSave();
+		deleteCookie(cookie);
+
+		return false;
+	}
 
-		emit cookieAdded(cookie);
+	if (indexCookie(cookie))
+	{
+		emit cookieRemoved(cookie);
 	}
 
-	return result;
+	addRecord(InsertCookieRecord, cookie);
+
+	emit cookieAdded(cookie);
+
+	return true;
 }
 
 bool CookieJar::deleteCookie(const QNetworkCookie &cookie)
 {
-	const bool result = QNetworkCookieJar::deleteCookie(cookie);
+	load();
 
-	if (result)
+	if (!unindexCookie(cookie))
 	{
-		scheduleSave();
-
-		emit cookieRemoved(cookie);
+		return false;
 	}
 
-	return result;
+	addRecord(DeleteCookieRecord, cookie);
+
+	emit cookieRemoved(cookie);
+
+	return true;
 }
 
 bool CookieJar::updateCookie(const QNetworkCookie &cookie)
@@ -225,14 +435,95 @@ bool CookieJar::updateCookie(const QNetworkCookie &cookie)
 		return false;
 	}
 
-	const bool result = QNetworkCookieJar::updateCookie(cookie);
+	load();
+
+	const QList<QNetworkCookie> cookies = m_cookies.value(getDomainKey(cookie.domain()));
 
-	if (result)
+	for (int i = 0; i < cookies.count(); ++i)
 	{
-		scheduleSave();
+		if (cookies.at(i).hasSameIdentifier(cookie))
+		{
+			return insertCookie(cookie);
+		}
+	}
+
+	return false;
+}
+
+bool CookieJar::indexCookie(const QNetworkCookie &cookie)
+{
+	QList<QNetworkCookie> &cookies = m_cookies[getDomainKey(cookie.domain())];
+
+	for (int i = 0; i < cookies.count(); ++i)
+	{
+		if (cookies.at(i).hasSameIdentifier(cookie))
+		{
+			cookies[i] = cookie;
+
+			return true;
+		}
+	}
+
+	cookies.append(cookie);
+
+	++m_cookiesAmount;
+
+	return false;
+}
+
+bool CookieJar::unindexCookie(const QNetworkCookie &cookie)
+{
+	const QString key = getDomainKey(cookie.domain());
+	QHash<QString, QList<QNetworkCookie> >::iterator iterator = m_cookies.find(key);
+
+	if (iterator == m_cookies.end())
+	{
+		return false;
+	}
+
+	for (int i = 0; i < iterator.value().count(); ++i)
+	{
+		if (iterator.value().at(i).hasSameIdentifier(cookie))
+		{
+			iterator.value().removeAt(i);
+
+			--m_cookiesAmount;
+
+			if (iterator.value().isEmpty())
+			{
+				m_cookies.erase(iterator);
+			}
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool CookieJar::isParentDomain(const QString &domain, const QString &reference)
+{
+	if (!reference.startsWith(QLatin1Char('.')))
+	{
+		return (domain == reference);
+	}
+
+	return (domain.endsWith(reference) || domain == reference.mid(1));
+}
+
+bool CookieJar::isParentPath(const QString &path, const QString &reference)
+{
+	if (reference.isEmpty() || reference == QLatin1String("/"))
+	{
+		return true;
+	}
+
+	if (!path.startsWith(reference))
+	{
+		return false;
 	}
 
-	return result;
+	return (reference.endsWith(QLatin1Char('/')) || path.length() == reference.length() || path.at(reference.length()) == QLatin1Char('/'));
 }
 
 }
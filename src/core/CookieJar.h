@@ -46,10 +46,19 @@ public:
 		AcceptExistingCookies = 2
 	};
 
+	enum CookieRecordType
+	{
+		UnknownCookieRecord = 0,
+		InsertCookieRecord = 1,
+		DeleteCookieRecord = 2
+	};
+
 	explicit CookieJar(bool isPrivate, QObject *parent = NULL);
+	~CookieJar();
 
 	void clearCookies(int period = 0);
-	CookieJar* clone(QObject *parent = NULL);
+	void ref();
+	bool deref();
 	QList<QNetworkCookie> cookiesForUrl(const QUrl &url) const;
 	QList<QNetworkCookie> getCookies(const QString &domain = QString()) const;
 	KeepCookiesPolicy getKeepCookiesPolicy() const;
@@ -61,15 +70,31 @@ public:
 protected:
 	void timerEvent(QTimerEvent *event);
 	void scheduleSave();
+	void load();
+	void saveCookies();
+	void saveJournal();
+	void addRecord(CookieRecordType type, const QNetworkCookie &cookie);
+	void setCookies(const QList<QNetworkCookie> &cookies);
+	static QString getDomainKey(const QString &domain);
+	bool indexCookie(const QNetworkCookie &cookie);
+	bool unindexCookie(const QNetworkCookie &cookie);
+	static bool isParentDomain(const QString &domain, const QString &reference);
+	static bool isParentPath(const QString &path, const QString &reference);
 
 protected slots:
-	void optionChanged(const QString &option, const QVariant &value);
+	void optionChanged(int identifier, const QVariant &value);
 
 private:
+	QHash<QString, QList<QNetworkCookie> > m_cookies;
+	QByteArray m_pendingRecords;
 	KeepCookiesPolicy m_keepCookiesPolicy;
 	ThirdPartyCookiesAcceptPolicy m_thirdPartyCookiesAcceptPolicy;
 	int m_saveTimer;
+	int m_journalRecords;
+	int m_cookiesAmount;
+	int m_references;
 	bool m_enableCookies;
+	bool m_isLoaded;
 	bool m_isPrivate;
 
 signals:
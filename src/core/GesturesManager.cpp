@@ -38,7 +38,7 @@ GesturesManager::GesturesManager(QObject *parent) : QObject(parent)
 
 	loadProfiles();
 
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), m_instance, SLOT(optionChanged(QString)));
+	SettingsManager::addListener(m_instance, QList<int>() << SettingsManager::Browser_GesturesProfilesOrderOption);
 }
 
 void GesturesManager::createInstance(QObject *parent)
@@ -49,9 +49,11 @@ void GesturesManager::createInstance(QObject *parent)
 	}
 }
 
-void GesturesManager::optionChanged(const QString &option)
+void GesturesManager::optionChanged(int identifier, const QVariant &value)
 {
-	if (option == QLatin1String("Browser/GesturesProfilesOrder"))
+	Q_UNUSED(value)
+
+	if (identifier == SettingsManager::Browser_GesturesProfilesOrderOption)
 	{
 		loadProfiles();
 	}
@@ -58,7 +58,7 @@ protected:
 	bool eventFilter(QObject *object, QEvent *event);
 
 protected slots:
-	void optionChanged(const QString &option);
+	void optionChanged(int identifier, const QVariant &value);
 
 private:
 	static GesturesManager *m_instance;
@@ -42,10 +42,10 @@ HistoryManager::HistoryManager(QObject *parent) : QObject(parent),
 {
 	m_dayTimer = startTimer(QTime::currentTime().msecsTo(QTime(23, 59, 59, 999)));
 
-	optionChanged(QLatin1String("History/RememberBrowsing"));
-	optionChanged(QLatin1String("History/StoreFavicons"));
+	optionChanged(SettingsManager::History_RememberBrowsingOption, SettingsManager::getValue(SettingsManager::History_RememberBrowsingOption));
+	optionChanged(SettingsManager::History_StoreFaviconsOption, SettingsManager::getValue(SettingsManager::History_StoreFaviconsOption));
 
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString)));
+	SettingsManager::addListener(this, QList<int>() << SettingsManager::Browser_PrivateModeOption << SettingsManager::History_RememberBrowsingOption << SettingsManager::History_StoreFaviconsOption);
 }
 
 void HistoryManager::createInstance(QObject *parent)
@@ -184,9 +184,9 @@ void HistoryManager::clearHistory(int period)
 	emit m_instance->cleared();
 }
 
-void HistoryManager::optionChanged(const QString &option)
+void HistoryManager::optionChanged(int identifier, const QVariant &value)
 {
-	if (option == QLatin1String("History/RememberBrowsing") || option == QLatin1String("Browser/PrivateMode"))
+	if (identifier == SettingsManager::History_RememberBrowsingOption || identifier == SettingsManager::Browser_PrivateModeOption)
 	{
 		const bool enabled = (SettingsManager::getValue(QLatin1String("History/RememberBrowsing")).toBool() && !SettingsManager::getValue(QLatin1String("Browser/PrivateMode")).toBool());
 
@@ -217,9 +217,9 @@ void HistoryManager::optionChanged(const QString &option)
 
 		m_enabled = enabled;
 	}
-	else if (option == QLatin1String("History/StoreFavicons"))
+	else if (identifier == SettingsManager::History_StoreFaviconsOption)
 	{
-		m_storeFavicons = SettingsManager::getValue(option).toBool();
+		m_storeFavicons = value.toBool();
 	}
 }
 
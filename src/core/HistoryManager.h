@@ -70,7 +70,7 @@ protected:
 	static qint64 getIcon(const QIcon &icon, bool canCreate = true);
 
 protected slots:
-	void optionChanged(const QString &option);
+	void optionChanged(int identifier, const QVariant &value);
 
 private:
 	int m_cleanupTimer;
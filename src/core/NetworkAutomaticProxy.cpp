@@ -23,6 +23,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDate>
+#include <QtCore/QMutexLocker>
 #include <QtNetwork/QHostInfo>
 #include <QtNetwork/QNetworkInterface>
 
@@ -32,45 +33,104 @@ namespace Otter
 QStringList NetworkAutomaticProxy::m_months = QStringList() << QLatin1String("jan") << QLatin1String("feb") << QLatin1String("mar") << QLatin1String("apr") << QLatin1String("may") << QLatin1String("jun") << QLatin1String("jul") << QLatin1String("aug") << QLatin1String("sep") << QLatin1String("oct") << QLatin1String("nov") << QLatin1String("dec");
 QStringList NetworkAutomaticProxy::m_days = QStringList() << QLatin1String("mon") << QLatin1String("tue") << QLatin1String("wed") << QLatin1String("thu") << QLatin1String("fri") << QLatin1String("sat") << QLatin1String("sun");
 
-NetworkAutomaticProxy::NetworkAutomaticProxy()
+NetworkAutomaticProxy::NetworkAutomaticProxy() : QObject(),
+	m_thread(new QThread()),
+	m_engine(new QScriptEngine(this)),
+	m_localAddressExpiration(0)
 {
 	m_proxies.insert(QLatin1String("ERROR"), QList<QNetworkProxy>() << QNetworkProxy(QNetworkProxy::DefaultProxy));
 	m_proxies.insert(QLatin1String("DIRECT"), QList<QNetworkProxy>() << QNetworkProxy(QNetworkProxy::NoProxy));
 
-	m_engine.globalObject().setProperty(QLatin1String("alert"), m_engine.newFunction(alert));
-	m_engine.globalObject().setProperty(QLatin1String("shExpMatch"), m_engine.newFunction(shExpMatch));
-	m_engine.globalObject().setProperty(QLatin1String("dnsDomainIs"), m_engine.newFunction(dnsDomainIs));
-	m_engine.globalObject().setProperty(QLatin1String("isInNet"), m_engine.newFunction(isInNet));
-	m_engine.globalObject().setProperty(QLatin1String("myIpAddress"), m_engine.newFunction(myIpAddress));
-	m_engine.globalObject().setProperty(QLatin1String("dnsResolve"), m_engine.newFunction(dnsResolve));
-	m_engine.globalObject().setProperty(QLatin1String("isPlainHostName"), m_engine.newFunction(isPlainHostName));
-	m_engine.globalObject().setProperty(QLatin1String("isResolvable"), m_engine.newFunction(isResolvable));
-	m_engine.globalObject().setProperty(QLatin1String("localHostOrDomainIs"), m_engine.newFunction(localHostOrDomainIs));
-	m_engine.globalObject().setProperty(QLatin1String("dnsDomainLevels"), m_engine.newFunction(dnsDomainLevels));
-	m_engine.globalObject().setProperty(QLatin1String("weekdayRange"), m_engine.newFunction(weekdayRange));
-	m_engine.globalObject().setProperty(QLatin1String("dateRange"), m_engine.newFunction(dateRange));
-	m_engine.globalObject().setProperty(QLatin1String("timeRange"), m_engine.newFunction(timeRange));
+	m_engine->globalObject().setProperty(QLatin1String("alert"), m_engine->newFunction(alert));
+	m_engine->globalObject().setProperty(QLatin1String("shExpMatch"), m_engine->newFunction(shExpMatch));
+	m_engine->globalObject().setProperty(QLatin1String("dnsDomainIs"), m_engine->newFunction(dnsDomainIs));
+	m_engine->globalObject().setProperty(QLatin1String("isInNet"), m_engine->newFunction(isInNet));
+	m_engine->globalObject().setProperty(QLatin1String("myIpAddress"), m_engine->newFunction(myIpAddress));
+	m_engine->globalObject().setProperty(QLatin1String("dnsResolve"), m_engine->newFunction(dnsResolve));
+	m_engine->globalObject().setProperty(QLatin1String("isPlainHostName"), m_engine->newFunction(isPlainHostName));
+	m_engine->globalObject().setProperty(QLatin1String("isResolvable"), m_engine->newFunction(isResolvable));
+	m_engine->globalObject().setProperty(QLatin1String("localHostOrDomainIs"), m_engine->newFunction(localHostOrDomainIs));
+	m_engine->globalObject().setProperty(QLatin1String("dnsDomainLevels"), m_engine->newFunction(dnsDomainLevels));
+	m_engine->globalObject().setProperty(QLatin1String("weekdayRange"), m_engine->newFunction(weekdayRange));
+	m_engine->globalObject().setProperty(QLatin1String("dateRange"), m_engine->newFunction(dateRange));
+	m_engine->globalObject().setProperty(QLatin1String("timeRange"), m_engine->newFunction(timeRange));
+
+	moveToThread(m_thread);
+
+	m_thread->start();
 }
 
 QList<QNetworkProxy> NetworkAutomaticProxy::getProxy(const QString &url, const QString &host)
+{
+	const QString key = getDecisionKey(url, host);
+
+	m_decisionsMutex.lock();
+
+	if (m_decisions.contains(key) && m_decisions[key].expiration > QDateTime::currentMSecsSinceEpoch())
+	{
+		const QList<QNetworkProxy> proxies = m_decisions[key].proxies;
+
+		m_decisionsMutex.unlock();
+
+		return proxies;
+	}
+
+	m_decisionsMutex.unlock();
+
+	if (QThread::currentThread() == m_thread)
+	{
+		evaluateProxy(url, host);
+	}
+	else
+	{
+		QMetaObject::invokeMethod(this, "evaluateProxy", Qt::BlockingQueuedConnection, Q_ARG(QString, url), Q_ARG(QString, host));
+	}
+
+	QMutexLocker locker(&m_decisionsMutex);
+
+	if (m_decisions.contains(key))
+	{
+		return m_decisions[key].proxies;
+	}
+
+	return QList<QNetworkProxy>() << QNetworkProxy(QNetworkProxy::DefaultProxy);
+}
+
+void NetworkAutomaticProxy::evaluateProxy(const QString &url, const QString &host)
 {
 	QScriptValueList arguments;
-	arguments << m_engine.toScriptValue(url) << m_engine.toScriptValue(host);
+	arguments << m_engine->toScriptValue(url) << m_engine->toScriptValue(host);
 
-	const QScriptValue result = m_findProxy.call(m_engine.globalObject(), arguments);
+	const QScriptValue result = m_findProxy.call(m_engine->globalObject(), arguments);
+	QString configuration = QLatin1String("ERROR");
 
-	if (result.isError())
+	if (!result.isError())
 	{
-		return m_proxies[QLatin1String("ERROR")];
+		configuration = result.toString().remove(QLatin1Char(' '));
 	}
 
-	const QString configuration = result.toString().remove(QLatin1Char(' '));
+	ProxyDecision decision;
+	decision.expiration = (QDateTime::currentMSecsSinceEpoch() + 300000);
 
-	if (!m_proxies.value(configuration).isEmpty())
+	if (m_proxies.value(configuration).isEmpty())
 	{
-		return m_proxies[configuration];
+		m_proxies.insert(configuration, parseProxies(configuration));
 	}
 
+	decision.proxies = m_proxies[configuration];
+
+	QMutexLocker locker(&m_decisionsMutex);
+
+	if (m_decisions.count() > 1000)
+	{
+		m_decisions.clear();
+	}
+
+	m_decisions[getDecisionKey(url, host)] = decision;
+}
+
+QList<QNetworkProxy> NetworkAutomaticProxy::parseProxies(const QString &configuration)
+{
 // proxy format: "PROXY host:port; PROXY host:port", "PROXY host:port; SOCKS host:port" etc.
 // can be combination of DIRECT, PROXY, SOCKS
 	const QStringList proxies = configuration.split(QLatin1Char(';'));
@@ -102,21 +162,22 @@ QList<QNetworkProxy> NetworkAutomaticProxy::getProxy(const QString &url, const Q
 			continue;
 		}
 
-		Console::addMessage(QCoreApplication::translate("main", "Failed to parse entry of proxy auto-config (PAC):\n%1").arg(proxies.at(i)), NetworkMessageCategory, ErrorMessageLevel);
+		emit messageAdded(QCoreApplication::translate("main", "Failed to parse entry of proxy auto-config (PAC):\n%1").arg(proxies.at(i)), ErrorMessageLevel);
 
 		return m_proxies[QLatin1String("ERROR")];
 	}
 
-	m_proxies.insert(configuration, proxiesForQuery);
-
-	return m_proxies[configuration];
+	return proxiesForQuery;
 }
 
 QScriptValue NetworkAutomaticProxy::alert(QScriptContext *context, QScriptEngine *engine)
 {
-	Q_UNUSED(engine);
+	NetworkAutomaticProxy *automaticProxy = getAutomaticProxy(engine);
 
-	Console::addMessage(context->argument(0).toString(), NetworkMessageCategory, WarningMessageLevel);
+	if (automaticProxy)
+	{
+		emit automaticProxy->messageAdded(context->argument(0).toString(), WarningMessageLevel);
+	}
 
 	return engine->undefinedValue();
 }
@@ -171,14 +232,12 @@ QScriptValue NetworkAutomaticProxy::myIpAddress(QScriptContext *context, QScript
 		return context->throwError(QLatin1String("Function myIpAddress does not take any arguments!"));
 	}
 
-	const QList<QHostAddress> addresses = QNetworkInterface::allAddresses();
+	NetworkAutomaticProxy *automaticProxy = getAutomaticProxy(engine);
+	const QString address = (automaticProxy ? automaticProxy->getLocalAddress() : QString());
 
-	for (int i = 0; i < addresses.count(); ++i)
+	if (!address.isEmpty())
 	{
-		if (!addresses.at(i).isNull() && addresses.at(i) != QHostAddress::LocalHost && addresses.at(i) != QHostAddress::LocalHostIPv6 && addresses.at(i) != QHostAddress::Null && addresses.at(i) != QHostAddress::Broadcast && addresses.at(i) != QHostAddress::Any && addresses.at(i) != QHostAddress::AnyIPv6)
-		{
-			return addresses.at(i).toString();
-		}
+		return address;
 	}
 
 	return engine->undefinedValue();
@@ -191,11 +250,12 @@ QScriptValue NetworkAutomaticProxy::dnsResolve(QScriptContext *context, QScriptE
 		return context->throwError(QLatin1String("Function dnsResolve takes only one argument!"));
 	}
 
-	const QHostInfo host = QHostInfo::fromName(context->argument(0).toString());
+	NetworkAutomaticProxy *automaticProxy = getAutomaticProxy(engine);
+	const QString address = (automaticProxy ? automaticProxy->resolveHost(context->argument(0).toString()) : QString());
 
-	if (host.error() == QHostInfo::NoError)
+	if (!address.isEmpty())
 	{
-		return host.addresses().first().toString();
+		return address;
 	}
 
 	return engine->undefinedValue();
@@ -215,14 +275,14 @@ QScriptValue NetworkAutomaticProxy::isPlainHostName(QScriptContext *context, QSc
 
 QScriptValue NetworkAutomaticProxy::isResolvable(QScriptContext *context, QScriptEngine *engine)
 {
-	Q_UNUSED(engine);
-
 	if (context->argumentCount() != 1)
 	{
 		return context->throwError(QLatin1String("Function isResolvable takes only one argument!"));
 	}
 
-	return (QHostInfo::fromName(context->argument(0).toString()).error() == QHostInfo::NoError);
+	NetworkAutomaticProxy *automaticProxy = getAutomaticProxy(engine);
+
+	return (automaticProxy && !automaticProxy->resolveHost(context->argument(0).toString()).isEmpty());
 }
 
 QScriptValue NetworkAutomaticProxy::localHostOrDomainIs(QScriptContext *context, QScriptEngine *engine)
@@ -447,16 +507,97 @@ QDateTime NetworkAutomaticProxy::getDateTime(QScriptContext *context, int *numbe
 	return QDateTime::currentDateTime();
 }
 
+NetworkAutomaticProxy* NetworkAutomaticProxy::getAutomaticProxy(QScriptEngine *engine)
+{
+	return qobject_cast<NetworkAutomaticProxy*>(engine->parent());
+}
+
+QString NetworkAutomaticProxy::getDecisionKey(const QString &url, const QString &host)
+{
+	return (url.left(url.indexOf(QLatin1Char(':'))).toLower() + QLatin1String("://") + host.toLower());
+}
+
+QString NetworkAutomaticProxy::resolveHost(const QString &host)
+{
+	const qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+
+	if (m_hostAddresses.contains(host) && m_hostAddresses[host].second > currentTime)
+	{
+		return m_hostAddresses[host].first;
+	}
+
+	const QHostInfo information = QHostInfo::fromName(host);
+	const QString address = ((information.error() == QHostInfo::NoError && !information.addresses().isEmpty()) ? information.addresses().first().toString() : QString());
+
+	if (m_hostAddresses.count() > 500)
+	{
+		m_hostAddresses.clear();
+	}
+
+	m_hostAddresses[host] = qMakePair(address, (currentTime + 60000));
+
+	return address;
+}
+
+QString NetworkAutomaticProxy::getLocalAddress()
+{
+	const qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+
+	if (m_localAddressExpiration > currentTime)
+	{
+		return m_localAddress;
+	}
+
+	const QList<QHostAddress> addresses = QNetworkInterface::allAddresses();
+
+	m_localAddress = QString();
+	m_localAddressExpiration = (currentTime + 60000);
+
+	for (int i = 0; i < addresses.count(); ++i)
+	{
+		if (!addresses.at(i).isNull() && addresses.at(i) != QHostAddress::LocalHost && addresses.at(i) != QHostAddress::LocalHostIPv6 && addresses.at(i) != QHostAddress::Null && addresses.at(i) != QHostAddress::Broadcast && addresses.at(i) != QHostAddress::Any && addresses.at(i) != QHostAddress::AnyIPv6)
+		{
+			m_localAddress = addresses.at(i).toString();
+
+			break;
+		}
+	}
+
+	return m_localAddress;
+}
+
 bool NetworkAutomaticProxy::setup(const QString &script)
 {
-	if (!m_engine.canEvaluate(script) || m_engine.evaluate(script).isError())
+	if (QThread::currentThread() == m_thread)
+	{
+		return setupScript(script);
+	}
+
+	bool isSuccess = false;
+
+	QMetaObject::invokeMethod(this, "setupScript", Qt::BlockingQueuedConnection, Q_RETURN_ARG(bool, isSuccess), Q_ARG(QString, script));
+
+	return isSuccess;
+}
+
+bool NetworkAutomaticProxy::setupScript(const QString &script)
+{
+	m_hostAddresses.clear();
+
+	m_localAddressExpiration = 0;
+
+	const bool isValid = (m_engine->canEvaluate(script) && !m_engine->evaluate(script).isError());
+
+	if (isValid)
 	{
-		return false;
+		m_findProxy = m_engine->globalObject().property(QLatin1String("FindProxyForURL"));
 	}
 
-	m_findProxy = m_engine.globalObject().property(QLatin1String("FindProxyForURL"));
+	QMutexLocker locker(&m_decisionsMutex);
+
+	m_decisions.clear();
 
-	return m_findProxy.isFunction();
+	return (isValid && m_findProxy.isFunction());
 }
 
 bool NetworkAutomaticProxy::compareRange(const QVariant &valueOne, const QVariant &valueTwo, const QVariant &actualValue)
@@ -21,6 +21,8 @@
 #ifndef OTTER_NETWORKAUTOMATICPROXY_H
 #define OTTER_NETWORKAUTOMATICPROXY_H
 
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
 #include <QtNetwork/QNetworkProxy>
 #include <QtScript/QScriptEngine>
 #include <QtScript/QScriptValue>
@@ -28,8 +30,10 @@
 namespace Otter
 {
 
-class NetworkAutomaticProxy
+class NetworkAutomaticProxy : public QObject
 {
+	Q_OBJECT
+
 public:
 	explicit NetworkAutomaticProxy();
 
@@ -37,6 +41,21 @@ public:
 	bool setup(const QString &script);
 
 protected:
+	struct ProxyDecision
+	{
+		QList<QNetworkProxy> proxies;
+		qint64 expiration;
+
+		ProxyDecision() : expiration(0) {}
+	};
+
+	Q_INVOKABLE void evaluateProxy(const QString &url, const QString &host);
+	Q_INVOKABLE bool setupScript(const QString &script);
+	QString resolveHost(const QString &host);
+	QString getLocalAddress();
+	QList<QNetworkProxy> parseProxies(const QString &configuration);
+	static NetworkAutomaticProxy* getAutomaticProxy(QScriptEngine *engine);
+	static QString getDecisionKey(const QString &url, const QString &host);
 	static QScriptValue alert(QScriptContext *context, QScriptEngine *engine);
 	static QScriptValue dnsDomainIs(QScriptContext *context, QScriptEngine *engine);
 	static QScriptValue isInNet(QScriptContext *context, QScriptEngine *engine);
@@ -54,12 +73,21 @@ protected:
 	static bool compareRange(const QVariant &valueOne, const QVariant &valueTwo, const QVariant &actualValue);
 
 private:
-	QScriptEngine m_engine;
+	QThread *m_thread;
+	QScriptEngine *m_engine;
 	QScriptValue m_findProxy;
+	QMutex m_decisionsMutex;
+	QString m_localAddress;
 	QHash<QString, QList<QNetworkProxy> > m_proxies;
+	QHash<QString, ProxyDecision> m_decisions;
+	QHash<QString, QPair<QString, qint64> > m_hostAddresses;
+	qint64 m_localAddressExpiration;
 
 	static QStringList m_months;
 	static QStringList m_days;
+
+signals:
+	void messageAdded(const QString &note, int level);
 };
 
 }
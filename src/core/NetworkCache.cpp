@@ -18,17 +18,37 @@
 **************************************************************************/
 
 #include "NetworkCache.h"
+#include "NetworkCacheExpirer.h"
 #include "SessionsManager.h"
 #include "SettingsManager.h"
 
-#include <QtCore/QDateTime>
+#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
 #include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMap>
+#include <QtCore/QSaveFile>
+#include <QtCore/QTimerEvent>
+
+#include <cstring>
 
 namespace Otter
 {
 
-NetworkCache::NetworkCache(QObject *parent) : QNetworkDiskCache(parent)
+NetworkCache::NetworkCache(QObject *parent) : QNetworkDiskCache(parent),
+	m_expiryPool(new QThreadPool(this)),
+	m_cacheSize(0),
+	m_saveTimer(0),
+	m_expiryTimer(0),
+	m_memoryHitsAmount(0),
+	m_memoryMissesAmount(0),
+	m_isIndexLoaded(false),
+	m_isSaveUrgent(false)
 {
+	m_expiryPool->setMaxThreadCount(1);
+	m_memoryCache.setMaxCost(SettingsManager::getValue(QLatin1String("Cache/MemoryCacheLimit")).toInt() * 1024);
+
 	const QString cachePath = SessionsManager::getCachePath();
 
 	if (!cachePath.isEmpty())
@@ -39,7 +59,41 @@ NetworkCache::NetworkCache(QObject *parent) : QNetworkDiskCache(parent)
 		setMaximumCacheSize(SettingsManager::getValue(QLatin1String("Cache/DiskCacheLimit")).toInt() * 1024);
 	}
 
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString,QVariant)));
+	SettingsManager::addListener(this, QList<int>() << SettingsManager::Cache_DiskCacheLimitOption << SettingsManager::Cache_MemoryCacheLimitOption);
+}
+
+NetworkCache::~NetworkCache()
+{
+	m_expiryPool->waitForDone();
+
+	if (m_saveTimer != 0)
+	{
+		killTimer(m_saveTimer);
+
+		m_saveTimer = 0;
+
+		saveIndex();
+	}
+}
+
+void NetworkCache::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == m_saveTimer)
+	{
+		killTimer(m_saveTimer);
+
+		m_saveTimer = 0;
+
+		saveIndex();
+	}
+	else if (event->timerId() == m_expiryTimer)
+	{
+		killTimer(m_expiryTimer);
+
+		m_expiryTimer = 0;
+
+		expireEntries();
+	}
 }
 
 void NetworkCache::clearCache(int period)
@@ -53,6 +107,173 @@ void NetworkCache::clearCache(int period)
 		return;
 	}
 
+	loadIndex();
+
+	const QDateTime currentDateTime = QDateTime::currentDateTime();
+	QList<QUrl> entries;
+	QHash<QUrl, CacheEntry>::const_iterator iterator;
+
+	for (iterator = m_entries.constBegin(); iterator != m_entries.constEnd(); ++iterator)
+	{
+		if (iterator.value().lastModified.isValid() && iterator.value().lastModified.secsTo(currentDateTime) > (period * 3600))
+		{
+			entries.append(iterator.key());
+		}
+	}
+
+	for (int i = 0; i < entries.count(); ++i)
+	{
+		remove(entries.at(i));
+	}
+}
+
+void NetworkCache::clear()
+{
+	const QList<QIODevice*> devices = m_compressionDevices.keys();
+
+	for (int i = 0; i < devices.count(); ++i)
+	{
+		m_discardedDevices.insert(devices.at(i));
+	}
+
+	m_entries.clear();
+	m_memoryCache.clear();
+
+	m_cacheSize = 0;
+	m_isIndexLoaded = true;
+
+	m_expiringPathsMutex.lock();
+	m_expiringPaths.clear();
+	m_expiringPathsMutex.unlock();
+
+	QNetworkDiskCache::clear();
+
+	scheduleSave();
+}
+
+void NetworkCache::insert(QIODevice *device)
+{
+	if (m_compressionDevices.contains(device))
+	{
+		QNetworkCacheMetaData metaData = m_compressionDevices.take(device);
+
+		if (m_discardedDevices.remove(device))
+		{
+			delete device;
+
+			return;
+		}
+
+		const QByteArray data = qobject_cast<QBuffer*>(device)->data();
+		const QByteArray compressedData = qCompress(data);
+		const bool isCompressed = (compressedData.size() < (data.size() * 9 / 10));
+
+		delete device;
+
+		if (isCompressed)
+		{
+			QNetworkCacheMetaData::AttributesMap attributes = metaData.attributes();
+			attributes[getDecodedSizeAttribute()] = qint64(data.size());
+
+			metaData.setAttributes(attributes);
+		}
+
+		device = QNetworkDiskCache::prepare(metaData);
+
+		if (!device)
+		{
+			return;
+		}
+
+		device->write(isCompressed ? compressedData : data);
+
+		m_devices[device] = metaData;
+	}
+
+	QNetworkDiskCache::insert(device);
+
+	if (m_devices.contains(device))
+	{
+		const QNetworkCacheMetaData metaData = m_devices.take(device);
+
+		updateEntry(metaData);
+
+		emit entryAdded(metaData.url());
+	}
+}
+
+void NetworkCache::loadIndex()
+{
+	if (m_isIndexLoaded)
+	{
+		return;
+	}
+
+	m_isIndexLoaded = true;
+
+	if (cacheDirectory().isEmpty())
+	{
+		return;
+	}
+
+	QFile file(getIndexPath());
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		rebuildIndex();
+
+		return;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_2);
+
+	quint32 magic;
+	quint16 version;
+	quint32 amount;
+
+	stream >> magic >> version >> amount;
+
+	if (stream.status() != QDataStream::Ok || magic != 0x4F43494E || version != 3)
+	{
+		rebuildIndex();
+
+		return;
+	}
+
+	for (quint32 i = 0; i < amount; ++i)
+	{
+		QUrl url;
+		CacheEntry entry;
+
+		stream >> url >> entry.path >> entry.contentType >> entry.lastModified >> entry.expirationDate >> entry.size >> entry.decodedSize >> entry.lastAccess;
+
+		if (stream.status() != QDataStream::Ok)
+		{
+			rebuildIndex();
+
+			return;
+		}
+
+		if (url.isValid())
+		{
+			m_entries[url] = entry;
+
+			m_cacheSize += entry.size;
+		}
+	}
+
+	scheduleExpiry();
+}
+
+void NetworkCache::rebuildIndex()
+{
+	m_entries.clear();
+
+	m_cacheSize = 0;
+
+	m_isIndexLoaded = true;
+
 	const QDir cacheMainDirectory(cacheDirectory());
 	const QStringList directories = cacheMainDirectory.entryList(QDir::AllDirs | QDir::NoDotAndDotDot);
 
@@ -68,113 +289,577 @@ void NetworkCache::clearCache(int period)
 
 			for (int k = 0; k < files.count(); ++k)
 			{
-				const QNetworkCacheMetaData metaData = fileMetaData(cacheFilesDirectory.absoluteFilePath(files.at(k)));
+				const QString cacheFilePath = cacheFilesDirectory.absoluteFilePath(files.at(k));
+				const QNetworkCacheMetaData metaData = fileMetaData(cacheFilePath);
 
-				if (metaData.isValid() && metaData.lastModified().isValid() && metaData.lastModified().secsTo(QDateTime::currentDateTime()) > (period * 3600))
+				if (metaData.url().isValid())
 				{
-					remove(metaData.url());
+					const QFileInfo fileInformation(cacheFilePath);
+					CacheEntry entry;
+					entry.path = cacheFilePath;
+					entry.lastModified = metaData.lastModified();
+					entry.expirationDate = metaData.expirationDate();
+					entry.size = fileInformation.size();
+					entry.decodedSize = metaData.attributes().value(getDecodedSizeAttribute()).toLongLong();
+					entry.lastAccess = fileInformation.lastRead().toMSecsSinceEpoch();
+					entry.contentType = getContentType(metaData);
+
+					m_entries[metaData.url()] = entry;
+
+					m_cacheSize += entry.size;
 				}
 			}
 		}
 	}
+
+	scheduleSave();
+	scheduleExpiry();
 }
 
-void NetworkCache::insert(QIODevice *device)
+void NetworkCache::saveIndex()
 {
-	QNetworkDiskCache::insert(device);
+	if (cacheDirectory().isEmpty())
+	{
+		return;
+	}
 
-	if (m_devices.contains(device))
+	QSaveFile file(getIndexPath());
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_2);
+	stream << quint32(0x4F43494E) << quint16(3) << quint32(m_entries.count());
+
+	QHash<QUrl, CacheEntry>::const_iterator iterator;
+
+	for (iterator = m_entries.constBegin(); iterator != m_entries.constEnd(); ++iterator)
+	{
+		stream << iterator.key() << iterator.value().path << iterator.value().contentType << iterator.value().lastModified << iterator.value().expirationDate << iterator.value().size << iterator.value().decodedSize << iterator.value().lastAccess;
+	}
+
+	file.commit();
+}
+
+void NetworkCache::scheduleSave(bool isUrgent)
+{
+	if (cacheDirectory().isEmpty())
+	{
+		return;
+	}
+
+	if (m_saveTimer != 0)
+	{
+		if (!isUrgent || m_isSaveUrgent)
+		{
+			return;
+		}
+
+		killTimer(m_saveTimer);
+	}
+
+	m_isSaveUrgent = isUrgent;
+	m_saveTimer = startTimer(isUrgent ? 1000 : 30000);
+}
+
+void NetworkCache::scheduleExpiry()
+{
+	if (m_expiryTimer == 0 && maximumCacheSize() > 0 && m_cacheSize > maximumCacheSize())
+	{
+		m_expiryTimer = startTimer(0);
+	}
+}
+
+void NetworkCache::expireEntries()
+{
+	const qint64 limit = (maximumCacheSize() * 9 / 10);
+
+	if (maximumCacheSize() <= 0 || m_cacheSize <= limit)
+	{
+		return;
+	}
+
+	QMultiMap<qint64, QUrl> entries;
+	QHash<QUrl, CacheEntry>::const_iterator iterator;
+
+	for (iterator = m_entries.constBegin(); iterator != m_entries.constEnd(); ++iterator)
+	{
+		if (!iterator.value().path.isEmpty())
+		{
+			entries.insert(iterator.value().lastAccess, iterator.key());
+		}
+	}
+
+	QList<QUrl> removedEntries;
+	QStringList paths;
+	QMultiMap<qint64, QUrl>::const_iterator entriesIterator;
+
+	for (entriesIterator = entries.constBegin(); entriesIterator != entries.constEnd() && m_cacheSize > limit; ++entriesIterator)
+	{
+		const CacheEntry entry = m_entries.take(entriesIterator.value());
+
+		m_cacheSize -= entry.size;
+
+		m_memoryCache.remove(entriesIterator.value());
+
+		removedEntries.append(entriesIterator.value());
+		paths.append(entry.path);
+	}
+
+	if (paths.isEmpty())
+	{
+		return;
+	}
+
+	m_expiringPathsMutex.lock();
+
+	for (int i = 0; i < paths.count(); ++i)
+	{
+		m_expiringPaths.insert(paths.at(i));
+	}
+
+	m_expiringPathsMutex.unlock();
+
+	m_expiryPool->start(new NetworkCacheExpirer(this, paths));
+
+	scheduleSave();
+
+	for (int i = 0; i < removedEntries.count(); ++i)
+	{
+		emit entryRemoved(removedEntries.at(i));
+	}
+}
+
+void NetworkCache::removeExpiredFile(const QString &path)
+{
+	QMutexLocker locker(&m_expiringPathsMutex);
+
+	if (m_expiringPaths.remove(path))
+	{
+		QFile::remove(path);
+	}
+}
+
+void NetworkCache::updateEntry(const QNetworkCacheMetaData &metaData)
+{
+	if (!m_isIndexLoaded)
+	{
+		loadIndex();
+	}
+
+	CacheEntry entry;
+	entry.path = getCacheFilePath(metaData.url());
+
+	if (!QFile::exists(entry.path))
+	{
+		entry.path.clear();
+
+		if (!QNetworkDiskCache::metaData(metaData.url()).isValid())
+		{
+			return;
+		}
+	}
+
+	entry.lastModified = metaData.lastModified();
+	entry.expirationDate = metaData.expirationDate();
+	entry.size = (entry.path.isEmpty() ? 0 : QFileInfo(entry.path).size());
+	entry.contentType = getContentType(metaData);
+	entry.decodedSize = metaData.attributes().value(getDecodedSizeAttribute()).toLongLong();
+	entry.lastAccess = QDateTime::currentMSecsSinceEpoch();
+	entry.hits = m_entries.value(metaData.url()).hits;
+
+	m_cacheSize += (entry.size - m_entries.value(metaData.url()).size);
+
+	m_entries[metaData.url()] = entry;
+
+	scheduleSave();
+	scheduleExpiry();
+}
+
+void NetworkCache::updateMetaData(const QNetworkCacheMetaData &metaData)
+{
+	QNetworkDiskCache::updateMetaData(metaData);
+
+	MemoryEntry *memoryEntry = m_memoryCache.object(metaData.url());
+
+	if (memoryEntry)
 	{
-		emit entryAdded(m_devices[device]);
+		memoryEntry->metaData = metaData;
+	}
+}
+
+QIODevice* NetworkCache::data(const QUrl &url)
+{
+	return readData(url, true);
+}
 
-		m_devices.remove(device);
+QIODevice* NetworkCache::readData(const QUrl &url, bool isAccess)
+{
+	MemoryEntry *memoryEntry = (isAccess ? m_memoryCache.object(url) : NULL);
+
+	if (memoryEntry)
+	{
+		++m_memoryHitsAmount;
+
+		if (m_entries.contains(url))
+		{
+			m_entries[url].lastAccess = QDateTime::currentMSecsSinceEpoch();
+
+			scheduleSave(false);
+		}
+
+		QBuffer *buffer = new QBuffer();
+		buffer->setData(memoryEntry->data);
+		buffer->open(QIODevice::ReadOnly);
+
+		return buffer;
+	}
+
+	if (isAccess)
+	{
+		++m_memoryMissesAmount;
+	}
+
+	QIODevice *device = QNetworkDiskCache::data(url);
+
+	if (!device)
+	{
+		return device;
+	}
+
+	loadIndex();
+
+	bool isCompressed = false;
+
+	if (m_entries.contains(url))
+	{
+		if (isAccess)
+		{
+			++m_entries[url].hits;
+
+			m_entries[url].lastAccess = QDateTime::currentMSecsSinceEpoch();
+
+			scheduleSave(false);
+		}
+
+		isCompressed = (m_entries[url].decodedSize > 0);
+	}
+	else
+	{
+		isCompressed = QNetworkDiskCache::metaData(url).attributes().contains(getDecodedSizeAttribute());
+	}
+
+	// Small resources are kept in memory only after they were requested again
+	const bool canKeepInMemory = (isAccess && m_memoryCache.maxCost() > 0 && m_entries.value(url).hits >= 2);
+
+	if (!isCompressed && (!canKeepInMemory || device->size() > 131072 || device->size() > m_memoryCache.maxCost()))
+	{
+		return device;
+	}
+
+	QByteArray data = device->readAll();
+
+	delete device;
+
+	if (isCompressed)
+	{
+		const QByteArray compressedData = data;
+
+		data = qUncompress(compressedData);
+
+		if (data.isEmpty() && !compressedData.isEmpty())
+		{
+			remove(url);
+
+			return NULL;
+		}
 	}
+
+	if (canKeepInMemory && data.size() <= 131072 && data.size() <= m_memoryCache.maxCost())
+	{
+		memoryEntry = new MemoryEntry();
+		memoryEntry->metaData = QNetworkDiskCache::metaData(url);
+		memoryEntry->data = data;
+
+		if (memoryEntry->metaData.isValid())
+		{
+			m_memoryCache.insert(url, memoryEntry, memoryEntry->data.size());
+		}
+		else
+		{
+			delete memoryEntry;
+		}
+	}
+
+	QBuffer *buffer = new QBuffer();
+	buffer->setData(data);
+	buffer->open(QIODevice::ReadOnly);
+
+	return buffer;
 }
 
 QIODevice* NetworkCache::prepare(const QNetworkCacheMetaData &metaData)
 {
-	QIODevice *device = QNetworkDiskCache::prepare(metaData);
+	m_memoryCache.remove(metaData.url());
+
+	m_expiringPathsMutex.lock();
+	m_expiringPaths.remove(getCacheFilePath(metaData.url()));
+	m_expiringPathsMutex.unlock();
+
+	QNetworkCacheMetaData::AttributesMap attributes = metaData.attributes();
+	attributes.remove(getDecodedSizeAttribute());
+
+	QNetworkCacheMetaData cleanMetaData(metaData);
+	cleanMetaData.setAttributes(attributes);
+
+	if (canCompress(cleanMetaData))
+	{
+		QBuffer *buffer = new QBuffer(this);
+		buffer->open(QIODevice::ReadWrite);
+
+		m_compressionDevices[buffer] = cleanMetaData;
+
+		connect(buffer, SIGNAL(bytesWritten(qint64)), this, SLOT(handleCompressionDeviceWritten()));
+
+		return buffer;
+	}
+
+	QIODevice *device = QNetworkDiskCache::prepare(cleanMetaData);
 
 	if (device)
 	{
-		m_devices[device] = metaData.url();
+		m_devices[device] = cleanMetaData;
 	}
 
 	return device;
 }
 
+QNetworkCacheMetaData NetworkCache::metaData(const QUrl &url)
+{
+	MemoryEntry *memoryEntry = m_memoryCache.object(url);
+
+	if (memoryEntry)
+	{
+		return memoryEntry->metaData;
+	}
+
+	return QNetworkDiskCache::metaData(url);
+}
+
+QIODevice* NetworkCache::getEntryData(const QUrl &url)
+{
+	return readData(url, false);
+}
+
+QString NetworkCache::getIndexPath() const
+{
+	return QDir(cacheDirectory()).absoluteFilePath(QLatin1String("index.dat"));
+}
+
+QString NetworkCache::getContentType(const QNetworkCacheMetaData &metaData) const
+{
+	const QList<QNetworkCacheMetaData::RawHeader> headers = metaData.rawHeaders();
+
+	for (int i = 0; i < headers.count(); ++i)
+	{
+		if (headers.at(i).first.toLower() == QByteArray("content-type"))
+		{
+			return QString::fromLatin1(headers.at(i).second);
+		}
+	}
+
+	return QString();
+}
+
+QString NetworkCache::getCacheFilePath(const QUrl &url) const
+{
+	// Mirrors file naming used by QNetworkDiskCache, callers must verify that file exists
+	QUrl cleanUrl(url);
+	cleanUrl.setPassword(QString());
+	cleanUrl.setFragment(QString());
+
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(cleanUrl.toEncoded());
+
+	const QByteArray result = hash.result();
+	qlonglong value = 0;
+
+	memcpy(&value, result.constData(), sizeof(value));
+
+	const QByteArray identifier = QByteArray::number(value, 36).left(8);
+
+	return QDir(cacheDirectory()).absoluteFilePath(QStringLiteral("data8/%1/%2.d").arg(QString::number(uint(identifier.at(identifier.length() - 1)) % 16, 16)).arg(QString::fromLatin1(identifier)));
+}
+
 QString NetworkCache::getPathForUrl(const QUrl &url)
 {
-	if (!url.isValid() || !metaData(url).isValid())
+	if (!url.isValid())
 	{
 		return QString();
 	}
 
-	const QDir cacheMainDirectory(cacheDirectory());
-	const QStringList directories = cacheMainDirectory.entryList(QDir::AllDirs | QDir::NoDotAndDotDot);
+	loadIndex();
 
-	for (int i = 0; i < directories.count(); ++i)
+	if (!m_entries.contains(url))
 	{
-		const QDir cacheSubDirectory(cacheMainDirectory.absoluteFilePath(directories.at(i)));
-		const QStringList subDirectories = cacheSubDirectory.entryList(QDir::AllDirs | QDir::NoDotAndDotDot);
+		return QString();
+	}
 
-		for (int j = 0; j < subDirectories.count(); ++j)
+	CacheEntry &entry = m_entries[url];
+
+	if (entry.path.isEmpty() || !QFile::exists(entry.path))
+	{
+		const QString path = getCacheFilePath(url);
+
+		if (!QFile::exists(path))
 		{
-			const QDir cacheFilesDirectory(cacheSubDirectory.absoluteFilePath(subDirectories.at(j)));
-			const QStringList files = cacheFilesDirectory.entryList(QDir::Files);
+			m_cacheSize -= entry.size;
 
-			for (int k = 0; k < files.count(); ++k)
-			{
-				const QString cacheFilePath = cacheFilesDirectory.absoluteFilePath(files.at(k));
-				const QNetworkCacheMetaData metaData = fileMetaData(cacheFilePath);
+			m_entries.remove(url);
 
-				if (metaData.isValid() && url == metaData.url())
-				{
-					return cacheFilePath;
-				}
-			}
+			scheduleSave();
+
+			return QString();
 		}
+
+		entry.path = path;
+
+		scheduleSave();
 	}
 
-	return QString();
+	return entry.path;
+}
+
+NetworkCache::CacheEntry NetworkCache::getEntry(const QUrl &url) const
+{
+	const_cast<NetworkCache*>(this)->loadIndex();
+
+	return m_entries.value(url);
 }
 
 QList<QUrl> NetworkCache::getEntries() const
 {
-	QList<QUrl> entries;
+	const_cast<NetworkCache*>(this)->loadIndex();
 
-	const QDir cacheMainDirectory(cacheDirectory());
-	const QStringList directories = cacheMainDirectory.entryList(QDir::AllDirs | QDir::NoDotAndDotDot);
+	return m_entries.keys();
+}
 
-	for (int i = 0; i < directories.count(); ++i)
+QVariantHash NetworkCache::getStatistics() const
+{
+	QVariantHash statistics;
+	statistics[QLatin1String("memoryHits")] = m_memoryHitsAmount;
+	statistics[QLatin1String("memoryMisses")] = m_memoryMissesAmount;
+	statistics[QLatin1String("memoryEntries")] = m_memoryCache.count();
+	statistics[QLatin1String("memoryUsage")] = m_memoryCache.totalCost();
+	statistics[QLatin1String("diskUsage")] = m_cacheSize;
+
+	qint64 compressedSize = 0;
+	qint64 decodedSize = 0;
+	QHash<QUrl, CacheEntry>::const_iterator iterator;
+
+	for (iterator = m_entries.constBegin(); iterator != m_entries.constEnd(); ++iterator)
 	{
-		const QDir cacheSubDirectory(cacheMainDirectory.absoluteFilePath(directories.at(i)));
-		const QStringList subDirectories = cacheSubDirectory.entryList(QDir::AllDirs | QDir::NoDotAndDotDot);
-
-		for (int j = 0; j < subDirectories.count(); ++j)
+		if (iterator.value().decodedSize > 0)
 		{
-			const QDir cacheFilesDirectory(cacheSubDirectory.absoluteFilePath(subDirectories.at(j)));
-			const QStringList files = cacheFilesDirectory.entryList(QDir::Files);
+			compressedSize += iterator.value().size;
+			decodedSize += iterator.value().decodedSize;
+		}
+	}
 
-			for (int k = 0; k < files.count(); ++k)
-			{
-				const QNetworkCacheMetaData metaData = fileMetaData(cacheFilesDirectory.absoluteFilePath(files.at(k)));
+	statistics[QLatin1String("compressionRatio")] = ((decodedSize > 0) ? (qreal(compressedSize) / decodedSize) : qreal(1));
 
-				if (metaData.url().isValid())
-				{
-					entries.append(metaData.url());
-				}
-			}
+	return statistics;
+}
+
+QNetworkRequest::Attribute NetworkCache::getDecodedSizeAttribute()
+{
+	return static_cast<QNetworkRequest::Attribute>(QNetworkRequest::User + 1);
+}
+
+qint64 NetworkCache::expire()
+{
+	if (maximumCacheSize() <= 0)
+	{
+		return QNetworkDiskCache::expire();
+	}
+
+	loadIndex();
+	scheduleExpiry();
+
+	return m_cacheSize;
+}
+
+bool NetworkCache::canCompress(const QNetworkCacheMetaData &metaData) const
+{
+	if (cacheDirectory().isEmpty() || !metaData.isValid() || !metaData.saveToDisk() || !SettingsManager::getValue(QLatin1String("Cache/EnableCompression")).toBool())
+	{
+		return false;
+	}
+
+	const QList<QNetworkCacheMetaData::RawHeader> headers = metaData.rawHeaders();
+	qint64 contentLength = -1;
+
+	for (int i = 0; i < headers.count(); ++i)
+	{
+		if (headers.at(i).first.toLower() == QByteArray("content-length"))
+		{
+			contentLength = headers.at(i).second.toLongLong();
+
+			break;
 		}
 	}
 
-	return entries;
+	if (contentLength > 8388608)
+	{
+		return false;
+	}
+
+	const QString contentType = getContentType(metaData).section(QLatin1Char(';'), 0, 0).trimmed().toLower();
+	const bool isScript = (contentType.endsWith(QLatin1String("javascript")) || contentType.endsWith(QLatin1String("ecmascript")));
+
+	if (!contentType.startsWith(QLatin1String("text/")) && !isScript && !contentType.endsWith(QLatin1String("json")) && !contentType.endsWith(QLatin1String("xml")))
+	{
+		return false;
+	}
+
+	// QNetworkDiskCache compresses text and scripts on its own if their length is known and below 3 MB
+	return !((contentType.startsWith(QLatin1String("text/")) || isScript) && contentLength >= 0 && contentLength <= 3145728);
 }
 
 bool NetworkCache::remove(const QUrl &url)
 {
+	m_memoryCache.remove(url);
+
+	QHash<QIODevice*, QNetworkCacheMetaData>::iterator iterator = m_compressionDevices.begin();
+
+	while (iterator != m_compressionDevices.end())
+	{
+		if (iterator.value().url() == url)
+		{
+			m_discardedDevices.remove(iterator.key());
+
+			delete iterator.key();
+
+			iterator = m_compressionDevices.erase(iterator);
+		}
+		else
+		{
+			++iterator;
+		}
+	}
+
 	const bool result = QNetworkDiskCache::remove(url);
 
+	if (m_isIndexLoaded && m_entries.contains(url))
+	{
+		m_cacheSize -= m_entries.take(url).size;
+
+		scheduleSave();
+	}
+
 	if (result)
 	{
 		emit entryRemoved(url);
@@ -183,11 +868,38 @@ bool NetworkCache::remove(const QUrl &url)
 	return result;
 }
 
-void NetworkCache::optionChanged(const QString &option, const QVariant &value)
+void NetworkCache::handleCompressionDeviceWritten()
+{
+	QBuffer *buffer = qobject_cast<QBuffer*>(sender());
+
+	if (!buffer || !m_compressionDevices.contains(buffer))
+	{
+		return;
+	}
+
+	// Bodies of unknown length are buffered only up to 8 MB, larger ones are not cached at all
+	if (buffer->size() > 8388608)
+	{
+		m_discardedDevices.insert(buffer);
+	}
+
+	if (m_discardedDevices.contains(buffer))
+	{
+		buffer->buffer().clear();
+		buffer->seek(0);
+	}
+}
+
+void NetworkCache::optionChanged(int identifier, const QVariant &value)
 {
-	if (option == QLatin1String("Cache/DiskCacheLimit"))
+	if (identifier == SettingsManager::Cache_DiskCacheLimitOption)
 	{
 		setMaximumCacheSize(value.toInt() * 1024);
+		scheduleExpiry();
+	}
+	else if (identifier == SettingsManager::Cache_MemoryCacheLimitOption)
+	{
+		m_memoryCache.setMaxCost(value.toInt() * 1024);
 	}
 }
 
@@ -20,7 +20,14 @@
 #ifndef OTTER_NETWORKCACHE_H
 #define OTTER_NETWORKCACHE_H
 
+#include <QtCore/QCache>
+#include <QtCore/QDateTime>
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVariant>
 #include <QtNetwork/QNetworkDiskCache>
+#include <QtNetwork/QNetworkRequest>
 
 namespace Otter
 {
@@ -30,25 +37,88 @@ class NetworkCache : public QNetworkDiskCache
 	Q_OBJECT
 
 public:
+	struct CacheEntry
+	{
+		QString path;
+		QString contentType;
+		QDateTime lastModified;
+		QDateTime expirationDate;
+		qint64 size;
+		qint64 decodedSize;
+		qint64 lastAccess;
+		int hits;
+
+		CacheEntry() : size(0), decodedSize(0), lastAccess(0), hits(0) {}
+	};
+
 	explicit NetworkCache(QObject *parent = NULL);
+	~NetworkCache();
 
 	void clearCache(int period = 0);
+	void clear();
 	void insert(QIODevice *device);
+	void updateMetaData(const QNetworkCacheMetaData &metaData);
+	QIODevice* data(const QUrl &url);
 	QIODevice* prepare(const QNetworkCacheMetaData &metaData);
+	QIODevice* getEntryData(const QUrl &url);
+	QNetworkCacheMetaData metaData(const QUrl &url);
 	QString getPathForUrl(const QUrl &url);
+	CacheEntry getEntry(const QUrl &url) const;
 	QList<QUrl> getEntries() const;
+	QVariantHash getStatistics() const;
 	bool remove(const QUrl &url);
 
+protected:
+	struct MemoryEntry
+	{
+		QNetworkCacheMetaData metaData;
+		QByteArray data;
+	};
+
+	void timerEvent(QTimerEvent *event);
+	void loadIndex();
+	void rebuildIndex();
+	void saveIndex();
+	void scheduleSave(bool isUrgent = true);
+	void scheduleExpiry();
+	void expireEntries();
+	void removeExpiredFile(const QString &path);
+	void updateEntry(const QNetworkCacheMetaData &metaData);
+	QIODevice* readData(const QUrl &url, bool isAccess);
+	QString getIndexPath() const;
+	QString getContentType(const QNetworkCacheMetaData &metaData) const;
+	QString getCacheFilePath(const QUrl &url) const;
+	static QNetworkRequest::Attribute getDecodedSizeAttribute();
+	qint64 expire();
+	bool canCompress(const QNetworkCacheMetaData &metaData) const;
+
 protected slots:
-	void optionChanged(const QString &option, const QVariant &value);
+	void optionChanged(int identifier, const QVariant &value);
+	void handleCompressionDeviceWritten();
 
 private:
-	QHash<QIODevice*, QUrl> m_devices;
+	QThreadPool *m_expiryPool;
+	QHash<QIODevice*, QNetworkCacheMetaData> m_devices;
+	QHash<QIODevice*, QNetworkCacheMetaData> m_compressionDevices;
+	QSet<QIODevice*> m_discardedDevices;
+	QHash<QUrl, CacheEntry> m_entries;
+	QCache<QUrl, MemoryEntry> m_memoryCache;
+	QSet<QString> m_expiringPaths;
+	QMutex m_expiringPathsMutex;
+	qint64 m_cacheSize;
+	int m_saveTimer;
+	int m_expiryTimer;
+	int m_memoryHitsAmount;
+	int m_memoryMissesAmount;
+	bool m_isIndexLoaded;
+	bool m_isSaveUrgent;
 
 signals:
 	void cleared();
 	void entryAdded(QUrl url);
 	void entryRemoved(QUrl url);
+
+friend class NetworkCacheExpirer;
 };
 
 }
@@ -0,0 +1,39 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2013 - 2014 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "NetworkCacheExpirer.h"
+
+namespace Otter
+{
+
+NetworkCacheExpirer::NetworkCacheExpirer(NetworkCache *cache, const QStringList &paths) : QRunnable(),
+	m_cache(cache),
+	m_paths(paths)
+{
+}
+
+void NetworkCacheExpirer::run()
+{
+	for (int i = 0; i < m_paths.count(); ++i)
+	{
+		m_cache->removeExpiredFile(m_paths.at(i));
+	}
+}
+
+}
@@ -23,6 +23,7 @@
 #include "LocalListingNetworkReply.h"
 #include "NetworkCache.h"
 #include "NetworkManagerFactory.h"
+#include "NetworkTransport.h"
 #include "SessionsManager.h"
 #include "SettingsManager.h"
 #include "Utils.h"
@@ -32,17 +33,21 @@
 #include <QtCore/QFileInfo>
 #include <QtWidgets/QMessageBox>
 #include <QtNetwork/QNetworkProxy>
+#include <QtNetwork/QNetworkReply>
 
 namespace Otter
 {
 
 NetworkManager::NetworkManager(bool isPrivate, QObject *parent) : QNetworkAccessManager(parent),
+	m_transport(NULL),
 	m_cookieJar(NULL)
 {
 	NetworkManagerFactory::initialize();
 
 	if (!isPrivate)
 	{
+		m_transport = NetworkManagerFactory::getTransport();
+
 		m_cookieJar = NetworkManagerFactory::getCookieJar();
 
 		setCookieJar(m_cookieJar);
@@ -57,9 +62,7 @@ NetworkManager::NetworkManager(bool isPrivate, QObject *parent) : QNetworkAccess
 	}
 	else
 	{
-		m_cookieJar = new CookieJar(true, this);
-
-		setCookieJar(m_cookieJar);
+		setSharedCookieJar(new CookieJar(true));
 	}
 
 	connect(this, SIGNAL(authenticationRequired(QNetworkReply*,QAuthenticator*)), this, SLOT(handleAuthenticationRequired(QNetworkReply*,QAuthenticator*)));
@@ -67,6 +70,14 @@ NetworkManager::NetworkManager(bool isPrivate, QObject *parent) : QNetworkAccess
 	connect(this, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), this, SLOT(handleSslErrors(QNetworkReply*,QList<QSslError>)));
 }
 
+NetworkManager::~NetworkManager()
+{
+	if (m_cookieJar && !m_transport && !m_cookieJar->deref())
+	{
+		delete m_cookieJar;
+	}
+}
+
 void NetworkManager::handleAuthenticationRequired(QNetworkReply *reply, QAuthenticator *authenticator)
 {
 	AuthenticationDialog dialog(reply->url(), authenticator, SessionsManager::getActiveWindow());
@@ -130,6 +141,37 @@ void NetworkManager::handleSslErrors(QNetworkReply *reply, const QList<QSslError
 	}
 }
 
+void NetworkManager::handleReplyFinished()
+{
+	QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+
+	if (reply)
+	{
+		emit finished(reply);
+	}
+}
+
+void NetworkManager::setSharedCookieJar(CookieJar *cookieJar)
+{
+	if (!cookieJar || cookieJar == m_cookieJar)
+	{
+		return;
+	}
+
+	cookieJar->ref();
+
+	setCookieJar(cookieJar);
+
+	cookieJar->setParent(NULL);
+
+	if (m_cookieJar && !m_transport && !m_cookieJar->deref())
+	{
+		delete m_cookieJar;
+	}
+
+	m_cookieJar = cookieJar;
+}
+
 CookieJar* NetworkManager::getCookieJar()
 {
 	return m_cookieJar;
@@ -165,7 +207,21 @@ QNetworkReply* NetworkManager::createRequest(QNetworkAccessManager::Operation op
 
 	mutableRequest.setRawHeader(QStringLiteral("Accept-Language").toLatin1(), NetworkManagerFactory::getAcceptLanguage().toLatin1());
 
-	return QNetworkAccessManager::createRequest(operation, mutableRequest, outgoingData);
+	return sendRequest(operation, mutableRequest, outgoingData);
+}
+
+QNetworkReply* NetworkManager::sendRequest(QNetworkAccessManager::Operation operation, const QNetworkRequest &request, QIODevice *outgoingData)
+{
+	if (!m_transport)
+	{
+		return QNetworkAccessManager::createRequest(operation, request, outgoingData);
+	}
+
+	QNetworkReply *reply = m_transport->sendRequest(this, operation, request, outgoingData);
+
+	connect(reply, SIGNAL(finished()), this, SLOT(handleReplyFinished()));
+
+	return reply;
 }
 
 }
@@ -26,6 +26,7 @@ namespace Otter
 {
 
 class CookieJar;
+class NetworkTransport;
 
 class NetworkManager : public QNetworkAccessManager
 {
@@ -33,19 +34,26 @@ class NetworkManager : public QNetworkAccessManager
 
 public:
 	explicit NetworkManager(bool isPrivate = false, QObject *parent = NULL);
+	~NetworkManager();
 
 	CookieJar* getCookieJar();
 
 protected:
+	void setSharedCookieJar(CookieJar *cookieJar);
+	QNetworkReply* sendRequest(Operation operation, const QNetworkRequest &request, QIODevice *outgoingData);
 	virtual QNetworkReply* createRequest(Operation operation, const QNetworkRequest &request, QIODevice *outgoingData);
 
 protected slots:
 	virtual void handleAuthenticationRequired(QNetworkReply *reply, QAuthenticator *authenticator);
 	virtual void handleProxyAuthenticationRequired(const QNetworkProxy &proxy, QAuthenticator *authenticator);
 	virtual void handleSslErrors(QNetworkReply *reply, const QList<QSslError> &errors);
+	void handleReplyFinished();
 
 private:
+	NetworkTransport *m_transport;
 	CookieJar *m_cookieJar;
+
+friend class NetworkTransport;
 };
 
 }
@@ -24,6 +24,8 @@
 #include "NetworkCache.h"
 #include "NetworkManager.h"
 #include "NetworkProxyFactory.h"
+#include "NetworkTransport.h"
+#include "PreconnectManager.h"
 #include "SessionsManager.h"
 #include "SettingsManager.h"
 #include "WebBackend.h"
@@ -40,6 +42,7 @@ namespace Otter
 NetworkManagerFactory* NetworkManagerFactory::m_instance = NULL;
 CookieJar* NetworkManagerFactory::m_cookieJar = NULL;
 NetworkCache* NetworkManagerFactory::m_cache = NULL;
+NetworkTransport* NetworkManagerFactory::m_transport = NULL;
 QString NetworkManagerFactory::m_acceptLanguage;
 QStringList NetworkManagerFactory::m_userAgentsOrder;
 QMap<QString, UserAgentInformation> NetworkManagerFactory::m_userAgents;
@@ -63,6 +66,8 @@ void NetworkManagerFactory::createInstance(QObject *parent)
 		m_instance = new NetworkManagerFactory(parent);
 
 		ContentBlockingManager::createInstance(m_instance);
+
+		PreconnectManager::createInstance(m_instance);
 	}
 }
 
@@ -91,23 +96,23 @@ void NetworkManagerFactory::initialize()
 
 	loadUserAgents();
 
-	m_instance->optionChanged(QLatin1String("Network/AcceptLanguage"), SettingsManager::getValue(QLatin1String("Network/AcceptLanguage")));
-	m_instance->optionChanged(QLatin1String("Network/DoNotTrackPolicy"), SettingsManager::getValue(QLatin1String("Network/DoNotTrackPolicy")));
-	m_instance->optionChanged(QLatin1String("Network/EnableReferrer"), SettingsManager::getValue(QLatin1String("Network/EnableReferrer")));
-	m_instance->optionChanged(QLatin1String("Network/WorkOffline"), SettingsManager::getValue(QLatin1String("Network/WorkOffline")));
-	m_instance->optionChanged(QLatin1String("Proxy/UseSystemAuthentication"), SettingsManager::getValue(QLatin1String("Proxy/UseSystemAuthentication")));
-	m_instance->optionChanged(QLatin1String("Security/Ciphers"), SettingsManager::getValue(QLatin1String("Security/Ciphers")));
+	m_instance->optionChanged(SettingsManager::Network_AcceptLanguageOption, SettingsManager::getValue(SettingsManager::Network_AcceptLanguageOption));
+	m_instance->optionChanged(SettingsManager::Network_DoNotTrackPolicyOption, SettingsManager::getValue(SettingsManager::Network_DoNotTrackPolicyOption));
+	m_instance->optionChanged(SettingsManager::Network_EnableReferrerOption, SettingsManager::getValue(SettingsManager::Network_EnableReferrerOption));
+	m_instance->optionChanged(SettingsManager::Network_WorkOfflineOption, SettingsManager::getValue(SettingsManager::Network_WorkOfflineOption));
+	m_instance->optionChanged(SettingsManager::Proxy_UseSystemAuthenticationOption, SettingsManager::getValue(SettingsManager::Proxy_UseSystemAuthenticationOption));
+	m_instance->optionChanged(SettingsManager::Security_CiphersOption, SettingsManager::getValue(SettingsManager::Security_CiphersOption));
 
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), m_instance, SLOT(optionChanged(QString,QVariant)));
+	SettingsManager::addListener(m_instance, QList<int>() << SettingsManager::Network_AcceptLanguageOption << SettingsManager::Network_DoNotTrackPolicyOption << SettingsManager::Network_EnableReferrerOption << SettingsManager::Network_WorkOfflineOption << SettingsManager::Proxy_UseSystemAuthenticationOption << SettingsManager::Security_CiphersOption);
 }
 
-void NetworkManagerFactory::optionChanged(const QString &option, const QVariant &value)
+void NetworkManagerFactory::optionChanged(int identifier, const QVariant &value)
 {
-	if (option == QLatin1String("Network/AcceptLanguage"))
+	if (identifier == SettingsManager::Network_AcceptLanguageOption)
 	{
 		m_acceptLanguage = ((value.toString().isEmpty()) ? QLatin1String(" ") : value.toString().replace(QLatin1String("system"), QLocale::system().bcp47Name()));
 	}
-	else if (option == QLatin1String("Network/DoNotTrackPolicy"))
+	else if (identifier == SettingsManager::Network_DoNotTrackPolicyOption)
 	{
 		const QString policyValue = value.toString();
 
@@ -124,19 +129,19 @@ void NetworkManagerFactory::optionChanged(const QString &option, const QVariant
 			m_doNotTrackPolicy = SkipTrackPolicy;
 		}
 	}
-	else if (option == QLatin1String("Network/EnableReferrer"))
+	else if (identifier == SettingsManager::Network_EnableReferrerOption)
 	{
 		m_canSendReferrer = value.toBool();
 	}
-	else if (option == QLatin1String("Network/WorkOffline"))
+	else if (identifier == SettingsManager::Network_WorkOfflineOption)
 	{
 		m_isWorkingOffline = value.toBool();
 	}
-	else if (option == QLatin1String("Proxy/UseSystemAuthentication"))
+	else if (identifier == SettingsManager::Proxy_UseSystemAuthenticationOption)
 	{
 		m_isUsingSystemProxyAuthentication = value.toBool();
 	}
-	else if (option == QLatin1String("Security/Ciphers"))
+	else if (identifier == SettingsManager::Security_CiphersOption)
 	{
 		if (value.toString() == QLatin1String("default"))
 		{
@@ -222,6 +227,21 @@ NetworkCache* NetworkManagerFactory::getCache()
 	return m_cache;
 }
 
+NetworkTransport* NetworkManagerFactory::getTransport()
+{
+	if (!m_transport)
+	{
+		m_transport = new NetworkTransport(QCoreApplication::instance());
+		m_transport->setCookieJar(getCookieJar());
+		m_transport->setCache(getCache());
+
+		m_cookieJar->setParent(QCoreApplication::instance());
+		m_cache->setParent(QCoreApplication::instance());
+	}
+
+	return m_transport;
+}
+
 QString NetworkManagerFactory::getAcceptLanguage()
 {
 	return m_acceptLanguage;
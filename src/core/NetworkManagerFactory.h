@@ -40,6 +40,7 @@ class ContentsWidget;
 class CookieJar;
 class NetworkCache;
 class NetworkManager;
+class NetworkTransport;
 
 class NetworkManagerFactory : public QObject
 {
@@ -61,6 +62,7 @@ public:
 	static NetworkManagerFactory* getInstance();
 	static CookieJar* getCookieJar();
 	static NetworkCache* getCache();
+	static NetworkTransport* getTransport();
 	static QString getAcceptLanguage();
 	static QStringList getUserAgents();
 	static QList<QSslCipher> getDefaultCiphers();
@@ -76,12 +78,13 @@ protected:
 	static void initialize();
 
 protected slots:
-	void optionChanged(const QString &option, const QVariant &value);
+	void optionChanged(int identifier, const QVariant &value);
 
 private:
 	static NetworkManagerFactory *m_instance;
 	static CookieJar *m_cookieJar;
 	static NetworkCache *m_cache;
+	static NetworkTransport *m_transport;
 	static QString m_acceptLanguage;
 	static QStringList m_userAgentsOrder;
 	static QMap<QString, UserAgentInformation> m_userAgents;
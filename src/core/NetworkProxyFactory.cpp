@@ -23,6 +23,7 @@
 #include "SettingsManager.h"
 
 #include <QtCore/QFile>
+#include <QtCore/QThread>
 #include <QtNetwork/QNetworkProxy>
 
 namespace Otter
@@ -32,28 +33,38 @@ NetworkProxyFactory::NetworkProxyFactory() : QObject(), QNetworkProxyFactory(),
 	m_automaticProxy(NULL),
 	m_proxyMode(SystemProxy)
 {
-	optionChanged(QLatin1String("Network/ProxyMode"));
+	optionChanged(SettingsManager::Network_ProxyModeOption, SettingsManager::getValue(SettingsManager::Network_ProxyModeOption));
 
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString)));
+	SettingsManager::addListener(this, QList<int>() << SettingsManager::Network_ProxyModeOption);
+	SettingsManager::addGroupListener(this, QLatin1String("Proxy/"));
 }
 
 NetworkProxyFactory::~NetworkProxyFactory()
 {
 	if (m_automaticProxy)
 	{
-		delete m_automaticProxy;
+		QThread *thread = m_automaticProxy->thread();
+
+		m_automaticProxy->deleteLater();
+
+		thread->quit();
+		thread->wait();
+
+		delete thread;
 	}
 }
 
-void NetworkProxyFactory::optionChanged(const QString &option)
+void NetworkProxyFactory::optionChanged(int identifier, const QVariant &value)
 {
-	if ((option == QLatin1String("Network/ProxyMode") && SettingsManager::getValue(option) == QLatin1String("automatic")) || (option == QLatin1String("Proxy/AutomaticConfigurationPath") && m_proxyMode == AutomaticProxy))
+	if ((identifier == SettingsManager::Network_ProxyModeOption && value.toString() == QLatin1String("automatic")) || (identifier == SettingsManager::Proxy_AutomaticConfigurationPathOption && m_proxyMode == AutomaticProxy))
 	{
 		m_proxyMode = AutomaticProxy;
 
 		if (!m_automaticProxy)
 		{
 			m_automaticProxy = new NetworkAutomaticProxy();
+
+			connect(m_automaticProxy, SIGNAL(messageAdded(QString,int)), this, SLOT(addMessage(QString,int)));
 		}
 
 		const QString path = SettingsManager::getValue(QLatin1String("Proxy/AutomaticConfigurationPath")).toString();
@@ -68,7 +79,7 @@ void NetworkProxyFactory::optionChanged(const QString &option)
 
 		file.close();
 	}
-	else if ((option == QLatin1String("Network/ProxyMode") && SettingsManager::getValue(option) == QLatin1String("manual")) || (option.startsWith(QLatin1String("Proxy/")) && m_proxyMode == ManualProxy))
+	else if ((identifier == SettingsManager::Network_ProxyModeOption && value.toString() == QLatin1String("manual")) || (SettingsManager::getOptionName(identifier).startsWith(QLatin1String("Proxy/")) && m_proxyMode == ManualProxy))
 	{
 		m_proxyMode = ManualProxy;
 
@@ -92,13 +103,11 @@ void NetworkProxyFactory::optionChanged(const QString &option)
 			}
 		}
 	}
-	else if (option == QLatin1String("Network/ProxyMode"))
+	else if (identifier == SettingsManager::Network_ProxyModeOption)
 	{
 		m_proxies.clear();
 
-		const QString value = SettingsManager::getValue(option).toString();
-
-		if (value == QLatin1String("system"))
+		if (value.toString() == QLatin1String("system"))
 		{
 			m_proxyMode = SystemProxy;
 		}
@@ -110,6 +119,11 @@ void NetworkProxyFactory::optionChanged(const QString &option)
 	}
 }
 
+void NetworkProxyFactory::addMessage(const QString &note, int level)
+{
+	Console::addMessage(note, NetworkMessageCategory, static_cast<MessageLevel>(level));
+}
+
 QList<QNetworkProxy> NetworkProxyFactory::queryProxy(const QNetworkProxyQuery &query)
 {
 	if (m_proxyMode == SystemProxy)
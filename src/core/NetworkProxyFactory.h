@@ -48,7 +48,8 @@ public:
 	QList<QNetworkProxy> queryProxy(const QNetworkProxyQuery &query);
 
 protected slots:
-	void optionChanged(const QString &option);
+	void optionChanged(int identifier, const QVariant &value);
+	void addMessage(const QString &note, int level);
 
 private:
 	NetworkAutomaticProxy *m_automaticProxy;
@@ -0,0 +1,89 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2013 - 2014 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "NetworkTransport.h"
+#include "NetworkManager.h"
+#include "NetworkManagerFactory.h"
+#include "SessionsManager.h"
+#include "../ui/AuthenticationDialog.h"
+#include "../ui/MainWindow.h"
+
+#include <QtNetwork/QNetworkProxy>
+#include <QtNetwork/QNetworkReply>
+
+namespace Otter
+{
+
+NetworkTransport::NetworkTransport(QObject *parent) : QNetworkAccessManager(parent)
+{
+	connect(this, SIGNAL(authenticationRequired(QNetworkReply*,QAuthenticator*)), this, SLOT(handleAuthenticationRequired(QNetworkReply*,QAuthenticator*)));
+	connect(this, SIGNAL(proxyAuthenticationRequired(QNetworkProxy,QAuthenticator*)), this, SLOT(handleProxyAuthenticationRequired(QNetworkProxy,QAuthenticator*)));
+	connect(this, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), this, SLOT(handleSslErrors(QNetworkReply*,QList<QSslError>)));
+}
+
+void NetworkTransport::handleAuthenticationRequired(QNetworkReply *reply, QAuthenticator *authenticator)
+{
+	NetworkManager *manager = m_managers.value(reply);
+
+	if (manager)
+	{
+		manager->handleAuthenticationRequired(reply, authenticator);
+	}
+}
+
+void NetworkTransport::handleProxyAuthenticationRequired(const QNetworkProxy &proxy, QAuthenticator *authenticator)
+{
+	if (NetworkManagerFactory::isUsingSystemProxyAuthentication())
+	{
+		authenticator->setUser(QString());
+
+		return;
+	}
+
+	AuthenticationDialog dialog(QUrl(proxy.hostName()), authenticator, SessionsManager::getActiveWindow());
+	dialog.exec();
+}
+
+void NetworkTransport::handleSslErrors(QNetworkReply *reply, const QList<QSslError> &errors)
+{
+	NetworkManager *manager = m_managers.value(reply);
+
+	if (manager)
+	{
+		manager->handleSslErrors(reply, errors);
+	}
+}
+
+void NetworkTransport::removeReply(QObject *reply)
+{
+	m_managers.remove(reply);
+}
+
+QNetworkReply* NetworkTransport::sendRequest(NetworkManager *manager, QNetworkAccessManager::Operation operation, const QNetworkRequest &request, QIODevice *outgoingData)
+{
+	QNetworkReply *reply = QNetworkAccessManager::createRequest(operation, request, outgoingData);
+
+	m_managers[reply] = manager;
+
+	connect(reply, SIGNAL(destroyed(QObject*)), this, SLOT(removeReply(QObject*)));
+
+	return reply;
+}
+
+}
@@ -0,0 +1,52 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2013 - 2014 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_NETWORKTRANSPORT_H
+#define OTTER_NETWORKTRANSPORT_H
+
+#include <QtCore/QPointer>
+#include <QtNetwork/QNetworkAccessManager>
+
+namespace Otter
+{
+
+class NetworkManager;
+
+class NetworkTransport : public QNetworkAccessManager
+{
+	Q_OBJECT
+
+public:
+	explicit NetworkTransport(QObject *parent = NULL);
+
+	QNetworkReply* sendRequest(NetworkManager *manager, Operation operation, const QNetworkRequest &request, QIODevice *outgoingData);
+
+protected slots:
+	void handleAuthenticationRequired(QNetworkReply *reply, QAuthenticator *authenticator);
+	void handleProxyAuthenticationRequired(const QNetworkProxy &proxy, QAuthenticator *authenticator);
+	void handleSslErrors(QNetworkReply *reply, const QList<QSslError> &errors);
+	void removeReply(QObject *reply);
+
+private:
+	QHash<QObject*, QPointer<NetworkManager> > m_managers;
+};
+
+}
+
+#endif
@@ -0,0 +1,232 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2013 - 2014 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "PreconnectManager.h"
+#include "NetworkManagerFactory.h"
+#include "NetworkTransport.h"
+#include "SettingsManager.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QTimerEvent>
+
+namespace Otter
+{
+
+PreconnectManager* PreconnectManager::m_instance = NULL;
+QHash<QString, PreconnectManager::Speculation> PreconnectManager::m_speculations;
+int PreconnectManager::m_prefetchBudget = 16;
+int PreconnectManager::m_preconnectBudget = 4;
+int PreconnectManager::m_prefetchesAmount = 0;
+int PreconnectManager::m_preconnectsAmount = 0;
+int PreconnectManager::m_skippedAmount = 0;
+int PreconnectManager::m_hitsAmount = 0;
+int PreconnectManager::m_missesAmount = 0;
+
+PreconnectManager::PreconnectManager(QObject *parent) : QObject(parent),
+	m_expirationTimer(0)
+{
+}
+
+void PreconnectManager::createInstance(QObject *parent)
+{
+	if (!m_instance)
+	{
+		m_instance = new PreconnectManager(parent);
+	}
+}
+
+void PreconnectManager::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() != m_expirationTimer)
+	{
+		return;
+	}
+
+	const qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+	QHash<QString, Speculation>::iterator iterator = m_speculations.begin();
+
+	while (iterator != m_speculations.end())
+	{
+		if (iterator.value().expiration <= currentTime)
+		{
+			iterator = m_speculations.erase(iterator);
+
+			markResolved(false);
+		}
+		else
+		{
+			++iterator;
+		}
+	}
+
+	m_prefetchBudget = 16;
+	m_preconnectBudget = 4;
+
+	if (m_speculations.isEmpty())
+	{
+		killTimer(m_expirationTimer);
+
+		m_expirationTimer = 0;
+	}
+}
+
+void PreconnectManager::scheduleExpiration()
+{
+	if (m_expirationTimer == 0)
+	{
+		m_expirationTimer = startTimer(10000);
+	}
+}
+
+void PreconnectManager::markResolved(bool isHit)
+{
+	if (isHit)
+	{
+		++m_hitsAmount;
+	}
+	else
+	{
+		++m_missesAmount;
+	}
+}
+
+void PreconnectManager::handleLookupFinished(const QHostInfo &information)
+{
+	Q_UNUSED(information)
+}
+
+void PreconnectManager::prefetchHost(const QUrl &url)
+{
+	if (!canSpeculate(url))
+	{
+		return;
+	}
+
+	const QString host = url.host().toLower();
+
+	if (m_speculations.contains(host))
+	{
+		return;
+	}
+
+	if (m_prefetchBudget <= 0)
+	{
+		++m_skippedAmount;
+
+		return;
+	}
+
+	--m_prefetchBudget;
+	++m_prefetchesAmount;
+
+	Speculation speculation;
+	speculation.expiration = (QDateTime::currentMSecsSinceEpoch() + 60000);
+
+	m_speculations[host] = speculation;
+
+	QHostInfo::lookupHost(host, m_instance, SLOT(handleLookupFinished(QHostInfo)));
+
+	m_instance->scheduleExpiration();
+}
+
+void PreconnectManager::preconnect(const QUrl &url)
+{
+	if (!canSpeculate(url))
+	{
+		return;
+	}
+
+	const QString host = url.host().toLower();
+
+	if (m_speculations.value(host).isPreconnected)
+	{
+		return;
+	}
+
+	if (m_preconnectBudget <= 0)
+	{
+		++m_skippedAmount;
+
+		return;
+	}
+
+	--m_preconnectBudget;
+	++m_preconnectsAmount;
+
+	Speculation speculation;
+	speculation.expiration = (QDateTime::currentMSecsSinceEpoch() + 10000);
+	speculation.isPreconnected = true;
+
+	m_speculations[host] = speculation;
+
+#ifndef QT_NO_SSL
+	if (url.scheme() == QLatin1String("https"))
+	{
+		NetworkManagerFactory::getTransport()->connectToHostEncrypted(host, url.port(443));
+	}
+	else
+#endif
+	{
+		NetworkManagerFactory::getTransport()->connectToHost(host, url.port(80));
+	}
+
+	m_instance->scheduleExpiration();
+}
+
+void PreconnectManager::markRequested(const QUrl &url)
+{
+	if (m_speculations.isEmpty())
+	{
+		return;
+	}
+
+	if (m_speculations.remove(url.host().toLower()) > 0)
+	{
+		m_instance->markResolved(true);
+	}
+}
+
+bool PreconnectManager::canSpeculate(const QUrl &url)
+{
+	if (!m_instance || url.host().isEmpty() || (url.scheme() != QLatin1String("http") && url.scheme() != QLatin1String("https")))
+	{
+		return false;
+	}
+
+	return (!NetworkManagerFactory::isWorkingOffline() && SettingsManager::getValue(QLatin1String("Network/EnableSpeculativeConnections")).toBool());
+}
+
+PreconnectManager* PreconnectManager::getInstance()
+{
+	return m_instance;
+}
+
+QVariantHash PreconnectManager::getStatistics()
+{
+	QVariantHash statistics;
+	statistics[QLatin1String("prefetches")] = m_prefetchesAmount;
+	statistics[QLatin1String("preconnects")] = m_preconnectsAmount;
+	statistics[QLatin1String("skipped")] = m_skippedAmount;
+	statistics[QLatin1String("hits")] = m_hitsAmount;
+	statistics[QLatin1String("misses")] = m_missesAmount;
+
+	return statistics;
+}
+
+}
@@ -0,0 +1,78 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2013 - 2014 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_PRECONNECTMANAGER_H
+#define OTTER_PRECONNECTMANAGER_H
+
+#include <QtCore/QObject>
+#include <QtCore/QUrl>
+#include <QtCore/QVariant>
+#include <QtNetwork/QHostInfo>
+
+namespace Otter
+{
+
+class PreconnectManager : public QObject
+{
+	Q_OBJECT
+
+public:
+	static void createInstance(QObject *parent = NULL);
+	static void prefetchHost(const QUrl &url);
+	static void preconnect(const QUrl &url);
+	static void markRequested(const QUrl &url);
+	static PreconnectManager* getInstance();
+	static QVariantHash getStatistics();
+
+protected:
+	struct Speculation
+	{
+		qint64 expiration;
+		bool isPreconnected;
+
+		Speculation() : expiration(0), isPreconnected(false) {}
+	};
+
+	explicit PreconnectManager(QObject *parent = NULL);
+
+	void timerEvent(QTimerEvent *event);
+	void scheduleExpiration();
+	void markResolved(bool isHit);
+	static bool canSpeculate(const QUrl &url);
+
+protected slots:
+	void handleLookupFinished(const QHostInfo &information);
+
+private:
+	int m_expirationTimer;
+
+	static PreconnectManager *m_instance;
+	static QHash<QString, Speculation> m_speculations;
+	static int m_prefetchBudget;
+	static int m_preconnectBudget;
+	static int m_prefetchesAmount;
+	static int m_preconnectsAmount;
+	static int m_skippedAmount;
+	static int m_hitsAmount;
+	static int m_missesAmount;
+};
+
+}
+
+#endif
@@ -0,0 +1,253 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2013 - 2014 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "SessionWriter.h"
+#include "SettingsManager.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMetaObject>
+#include <QtCore/QSaveFile>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Otter
+{
+
+SessionWriter::SessionWriter() : QRunnable(),
+	m_resetJournal(false),
+	m_isSuccessful(false)
+{
+}
+
+void SessionWriter::run()
+{
+	QElapsedTimer timer;
+	timer.start();
+
+	m_isSuccessful = true;
+
+	if (!m_sessionPath.isEmpty())
+	{
+		m_isSuccessful = writeSession();
+	}
+
+	if (m_isSuccessful && !m_journalPath.isEmpty())
+	{
+		m_isSuccessful = writeJournal();
+	}
+
+	QMetaObject::invokeMethod(SessionsManager::getInstance(), "handleSessionWritten", Qt::QueuedConnection, Q_ARG(qint64, timer.elapsed()), Q_ARG(bool, !m_sessionPath.isEmpty()), Q_ARG(bool, m_isSuccessful));
+}
+
+void SessionWriter::setSession(const QString &path, const QString &legacyPath, const SessionInformation &session)
+{
+	m_sessionPath = path;
+	m_legacyPath = legacyPath;
+	m_session = session;
+
+	const QString defaultSearchEngine = SettingsManager::getValue(QLatin1String("Search/DefaultSearchEngine")).toString();
+	const QString defaultUserAgent = SettingsManager::getValue(QLatin1String("Network/UserAgent")).toString();
+
+	for (int i = 0; i < m_session.windows.count(); ++i)
+	{
+		for (int j = 0; j < m_session.windows.at(i).windows.count(); ++j)
+		{
+			removeDefaults(m_session.windows[i].windows[j], defaultSearchEngine, defaultUserAgent);
+		}
+	}
+}
+
+void SessionWriter::setJournal(const QString &path, bool reset)
+{
+	m_journalPath = path;
+	m_resetJournal = reset;
+}
+
+void SessionWriter::setJournalLayout(const QList<SessionMainWindow> &windows, const QList<QList<qint64> > &identifiers)
+{
+	m_layoutWindows = windows;
+	m_layoutIdentifiers = identifiers;
+}
+
+void SessionWriter::addJournalWindow(qint64 identifier, const SessionWindow &window)
+{
+	SessionWindow journalWindow = window;
+
+	removeDefaults(journalWindow, SettingsManager::getValue(QLatin1String("Search/DefaultSearchEngine")).toString(), SettingsManager::getValue(QLatin1String("Network/UserAgent")).toString());
+
+	m_journalWindows.append(qMakePair(identifier, journalWindow));
+}
+
+void SessionWriter::removeDefaults(SessionWindow &window, const QString &searchEngine, const QString &userAgent)
+{
+	if (window.searchEngine == searchEngine)
+	{
+		window.searchEngine = QString();
+	}
+
+	if (window.userAgent == userAgent)
+	{
+		window.userAgent = QString();
+	}
+}
+
+void SessionWriter::writeJournalLayout(QDataStream &stream)
+{
+	stream << quint8(SessionsManager::LayoutJournalRecord) << qint32(m_layoutWindows.count());
+
+	for (int i = 0; i < m_layoutWindows.count(); ++i)
+	{
+		stream << m_layoutWindows.at(i).geometry << m_layoutWindows.at(i).state << qint32(m_layoutWindows.at(i).index) << m_layoutIdentifiers.value(i);
+	}
+}
+
+void SessionWriter::writeSessionWindow(QDataStream &stream, const SessionWindow &window)
+{
+	stream << window.searchEngine << window.userAgent << qint32(window.group) << qint32(window.index) << qint32(window.reloadTime) << window.pinned << qint32(window.history.count());
+
+	for (int i = 0; i < window.history.count(); ++i)
+	{
+		stream << window.history.at(i).url << window.history.at(i).title << window.history.at(i).position << qint32(window.history.at(i).zoom);
+	}
+}
+
+bool SessionWriter::writeSession()
+{
+	QSaveFile file(m_sessionPath);
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+
+	int tabs = 0;
+
+	for (int i = 0; i < m_session.windows.count(); ++i)
+	{
+		tabs += m_session.windows.at(i).windows.count();
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_2);
+	stream << quint32(0x4F535331) << quint16(2) << m_session.title << m_session.clean << qint32(tabs) << qint32(m_session.windows.count());
+
+	for (int i = 0; i < m_session.windows.count(); ++i)
+	{
+		const SessionMainWindow &sessionEntry = m_session.windows.at(i);
+
+		stream << sessionEntry.geometry << sessionEntry.state << qint32(sessionEntry.index) << qint32(sessionEntry.windows.count());
+
+		for (int j = 0; j < sessionEntry.windows.count(); ++j)
+		{
+			writeSessionWindow(stream, sessionEntry.windows.at(j));
+		}
+	}
+
+	if (stream.status() != QDataStream::Ok || !synchronizeFile(&file) || !file.commit())
+	{
+		return false;
+	}
+
+	if (!m_legacyPath.isEmpty() && m_legacyPath != m_sessionPath)
+	{
+		QFile::remove(m_legacyPath);
+	}
+
+	return true;
+}
+
+bool SessionWriter::writeJournal()
+{
+	if (m_resetJournal)
+	{
+		if (m_session.clean)
+		{
+			QFile::remove(m_journalPath);
+
+			return true;
+		}
+
+		QSaveFile file(m_journalPath);
+
+		if (!file.open(QIODevice::WriteOnly))
+		{
+			return false;
+		}
+
+		QDataStream stream(&file);
+		stream.setVersion(QDataStream::Qt_5_2);
+		stream << quint32(0x4F534A31) << QFileInfo(m_sessionPath).lastModified();
+
+		writeJournalLayout(stream);
+
+		return (stream.status() == QDataStream::Ok && synchronizeFile(&file) && file.commit());
+	}
+
+	QFile file(m_journalPath);
+
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
+	{
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_2);
+
+	for (int i = 0; i < m_journalWindows.count(); ++i)
+	{
+		stream << quint8(SessionsManager::WindowJournalRecord) << m_journalWindows.at(i).first;
+
+		writeSessionWindow(stream, m_journalWindows.at(i).second);
+	}
+
+	if (!m_layoutWindows.isEmpty())
+	{
+		writeJournalLayout(stream);
+	}
+
+	return (stream.status() == QDataStream::Ok && synchronizeFile(&file));
+}
+
+bool SessionWriter::synchronizeFile(QFileDevice *file)
+{
+	if (!file->flush())
+	{
+		return false;
+	}
+
+#ifdef Q_OS_WIN
+	return (FlushFileBuffers(reinterpret_cast<HANDLE>(_get_osfhandle(file->handle()))) != 0);
+#else
+	return (fsync(file->handle()) == 0);
+#endif
+}
+
+bool SessionWriter::isSuccessful() const
+{
+	return m_isSuccessful;
+}
+
+}
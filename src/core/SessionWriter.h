@@ -0,0 +1,65 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2013 - 2014 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_SESSIONWRITER_H
+#define OTTER_SESSIONWRITER_H
+
+#include "SessionsManager.h"
+
+#include <QtCore/QFileDevice>
+#include <QtCore/QRunnable>
+
+namespace Otter
+{
+
+class SessionWriter : public QRunnable
+{
+public:
+	SessionWriter();
+
+	void run();
+	void setSession(const QString &path, const QString &legacyPath, const SessionInformation &session);
+	void setJournal(const QString &path, bool reset);
+	void setJournalLayout(const QList<SessionMainWindow> &windows, const QList<QList<qint64> > &identifiers);
+	void addJournalWindow(qint64 identifier, const SessionWindow &window);
+	static void writeSessionWindow(QDataStream &stream, const SessionWindow &window);
+	bool isSuccessful() const;
+
+protected:
+	bool writeSession();
+	bool writeJournal();
+	void writeJournalLayout(QDataStream &stream);
+	static void removeDefaults(SessionWindow &window, const QString &searchEngine, const QString &userAgent);
+	static bool synchronizeFile(QFileDevice *file);
+
+private:
+	SessionInformation m_session;
+	QString m_sessionPath;
+	QString m_legacyPath;
+	QString m_journalPath;
+	QList<SessionMainWindow> m_layoutWindows;
+	QList<QList<qint64> > m_layoutIdentifiers;
+	QList<QPair<qint64, SessionWindow> > m_journalWindows;
+	bool m_resetJournal;
+	bool m_isSuccessful;
+};
+
+}
+
+#endif
@@ -21,9 +21,14 @@
 #include "SessionsManager.h"
 #include "ActionsManager.h"
 #include "Application.h"
-#include "Utils.h"
+#include "ClosedWindowsStore.h"
+#include "Console.h"
+#include "PreconnectManager.h"
+#include "SessionWriter.h"
+#include "TabHibernationPolicy.h"
 #include "WindowsManager.h"
 #include "../ui/MainWindow.h"
+#include "../ui/Window.h"
 
 #include <QtCore/QDir>
 #include <QtCore/QSaveFile>
@@ -38,13 +43,38 @@ QString SessionsManager::m_session;
 QString SessionsManager::m_cachePath;
 QString SessionsManager::m_profilePath;
 QList<MainWindow*> SessionsManager::m_windows;
-QList<SessionMainWindow> SessionsManager::m_closedWindows;
+ClosedWindowsStore* SessionsManager::m_closedWindows = NULL;
+QHash<qint64, QPointer<Window> > SessionsManager::m_modifiedWindows;
+int SessionsManager::m_journalRecords = -1;
+QHash<QString, SessionSummary> SessionsManager::m_summaries;
+QList<QPointer<Window> > SessionsManager::m_restoreQueue;
+QList<QPair<QPointer<Window>, qint64> > SessionsManager::m_restoringWindows;
+QElapsedTimer SessionsManager::m_interactionTimer;
+int SessionsManager::m_restoreTotal = 0;
+bool SessionsManager::m_areSummariesValid = false;
 bool SessionsManager::m_isDirty = false;
+bool SessionsManager::m_isLayoutModified = false;
 bool SessionsManager::m_isPrivate = false;
 
 SessionsManager::SessionsManager(QObject *parent) : QObject(parent),
-	m_saveTimer(0)
+	m_writerPool(new QThreadPool(this)),
+	m_sessionsWatcher(new QFileSystemWatcher(this)),
+	m_hibernationPolicy(new TabHibernationPolicy(this)),
+	m_saveLatencies(9, 0),
+	m_savesAmount(0),
+	m_saveTimer(0),
+	m_restoreTimer(0)
 {
+	m_writerPool->setMaxThreadCount(1);
+
+	connect(m_sessionsWatcher, SIGNAL(directoryChanged(QString)), this, SLOT(handleSessionsChanged()));
+}
+
+SessionsManager::~SessionsManager()
+{
+	delete m_closedWindows;
+
+	m_closedWindows = NULL;
 }
 
 void SessionsManager::timerEvent(QTimerEvent *event)
@@ -59,7 +89,131 @@ void SessionsManager::timerEvent(QTimerEvent *event)
 
 		if (!m_isPrivate)
 		{
-			saveSession(QString(), QString(), NULL, false);
+			saveJournal();
+		}
+	}
+	else if (event->timerId() == m_restoreTimer)
+	{
+		restoreWindows();
+	}
+}
+
+bool SessionsManager::eventFilter(QObject *object, QEvent *event)
+{
+	if (event->type() == QEvent::KeyPress || event->type() == QEvent::MouseButtonPress || event->type() == QEvent::Wheel)
+	{
+		m_interactionTimer.start();
+	}
+
+	return QObject::eventFilter(object, event);
+}
+
+void SessionsManager::scheduleRestore(const QList<Window*> &windows)
+{
+	for (int i = 0; i < windows.count(); ++i)
+	{
+		if (windows.at(i) && windows.at(i)->getLoadingState() == DelayedState)
+		{
+			m_restoreQueue.append(windows.at(i));
+
+			++m_restoreTotal;
+
+			if (!windows.at(i)->isPrivate())
+			{
+				PreconnectManager::prefetchHost(windows.at(i)->getUrl());
+			}
+		}
+	}
+
+	if (m_instance->m_restoreTimer == 0 && !m_restoreQueue.isEmpty())
+	{
+		QCoreApplication::instance()->installEventFilter(m_instance);
+
+		m_instance->m_restoreTimer = m_instance->startTimer(250);
+	}
+
+	emit m_instance->restoreProgressChanged((m_restoreTotal - m_restoreQueue.count()), m_restoreTotal);
+}
+
+void SessionsManager::restoreWindows()
+{
+	const qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+
+	for (int i = (m_restoringWindows.count() - 1); i >= 0; --i)
+	{
+		if (!m_restoringWindows.at(i).first || (currentTime - m_restoringWindows.at(i).second) > 30000)
+		{
+			m_restoringWindows.removeAt(i);
+		}
+	}
+
+	if (m_interactionTimer.isValid() && m_interactionTimer.elapsed() < 1000)
+	{
+		return;
+	}
+
+	const int limit = qMax(1, SettingsManager::getValue(QLatin1String("Browser/BackgroundTabsRestoringLimit")).toInt());
+
+	while (m_restoringWindows.count() < limit && !m_restoreQueue.isEmpty())
+	{
+		QPointer<Window> window = m_restoreQueue.takeFirst();
+
+		if (window && window->getLoadingState() == DelayedState)
+		{
+			window->getContentsWidget();
+
+			m_restoringWindows.append(qMakePair(window, currentTime));
+
+			connect(window, SIGNAL(loadingStateChanged(WindowLoadingState)), this, SLOT(handleRestoringWindowLoaded()));
+		}
+	}
+
+	if (!m_restoreQueue.isEmpty() && m_restoreQueue.first() && !m_restoreQueue.first()->isPrivate())
+	{
+		PreconnectManager::preconnect(m_restoreQueue.first()->getUrl());
+	}
+
+	emit restoreProgressChanged((m_restoreTotal - m_restoreQueue.count()), m_restoreTotal);
+
+	if (m_restoreQueue.isEmpty())
+	{
+		QCoreApplication::instance()->removeEventFilter(this);
+
+		killTimer(m_restoreTimer);
+
+		m_restoreTimer = 0;
+		m_restoreTotal = 0;
+
+		for (int i = 0; i < m_restoringWindows.count(); ++i)
+		{
+			if (m_restoringWindows.at(i).first)
+			{
+				disconnect(m_restoringWindows.at(i).first, SIGNAL(loadingStateChanged(WindowLoadingState)), this, SLOT(handleRestoringWindowLoaded()));
+			}
+		}
+
+		m_restoringWindows.clear();
+	}
+}
+
+void SessionsManager::handleRestoringWindowLoaded()
+{
+	Window *window = qobject_cast<Window*>(sender());
+
+	if (!window || window->getLoadingState() != LoadedState)
+	{
+		return;
+	}
+
+	disconnect(window, SIGNAL(loadingStateChanged(WindowLoadingState)), this, SLOT(handleRestoringWindowLoaded()));
+
+	for (int i = 0; i < m_restoringWindows.count(); ++i)
+	{
+		if (m_restoringWindows.at(i).first == window)
+		{
+			m_restoringWindows.removeAt(i);
+
+			break;
 		}
 	}
 }
@@ -72,6 +226,7 @@ void SessionsManager::createInstance(const QString &profilePath, const QString &
 		m_cachePath = cachePath;
 		m_profilePath = profilePath;
 		m_isPrivate = isPrivate;
+		m_closedWindows = new ClosedWindowsStore();
 	}
 }
 
@@ -85,7 +240,7 @@ void SessionsManager::scheduleSave()
 
 void SessionsManager::clearClosedWindows()
 {
-	m_closedWindows.clear();
+	m_closedWindows->clear();
 
 	emit m_instance->closedWindowsChanged();
 }
@@ -113,7 +268,7 @@ void SessionsManager::storeClosedWindow(MainWindow *window)
 
 	if (!session.windows.isEmpty())
 	{
-		m_closedWindows.prepend(session);
+		m_closedWindows->addWindow(session);
 
 		emit m_instance->closedWindowsChanged();
 	}
@@ -121,12 +276,369 @@ void SessionsManager::storeClosedWindow(MainWindow *window)
 
 void SessionsManager::markSessionModified()
 {
-	if (!m_isPrivate && !m_isDirty && m_session == QLatin1String("default"))
+	if (!m_isPrivate && m_session == QLatin1String("default"))
+	{
+		m_isLayoutModified = true;
+
+		if (!m_isDirty)
+		{
+			m_isDirty = true;
+
+			m_instance->scheduleSave();
+		}
+	}
+}
+
+void SessionsManager::markSessionModified(Window *window)
+{
+	if (!window || window->isPrivate())
+	{
+		return;
+	}
+
+	if (!m_isPrivate && m_session == QLatin1String("default"))
+	{
+		m_modifiedWindows[window->getIdentifier()] = window;
+
+		if (!m_isDirty)
+		{
+			m_isDirty = true;
+
+			m_instance->scheduleSave();
+		}
+	}
+}
+
+void SessionsManager::saveJournal()
+{
+	const QFileInfo journalInformation(getJournalPath());
+
+	if (m_journalRecords < 0 || m_journalRecords >= 500 || (m_instance->m_writerPool->activeThreadCount() == 0 && (!journalInformation.exists() || journalInformation.size() > 1048576)))
+	{
+		SessionWriter *writer = createWriter(QString(), QString(), NULL, false);
+
+		if (writer)
+		{
+			m_instance->m_writerPool->start(writer);
+		}
+
+		return;
+	}
+
+	SessionWriter *writer = new SessionWriter();
+	writer->setJournal(getJournalPath(), false);
+
+	QHash<qint64, QPointer<Window> >::iterator iterator;
+
+	for (iterator = m_modifiedWindows.begin(); iterator != m_modifiedWindows.end(); ++iterator)
+	{
+		if (iterator.value())
+		{
+			writer->addJournalWindow(iterator.key(), iterator.value()->getSession());
+
+			++m_journalRecords;
+		}
+	}
+
+	if (m_isLayoutModified)
+	{
+		setJournalLayout(writer);
+
+		++m_journalRecords;
+	}
+
+	m_modifiedWindows.clear();
+	m_isLayoutModified = false;
+
+	m_instance->m_writerPool->start(writer);
+}
+
+void SessionsManager::updateSessionSummary()
+{
+	if (m_isPrivate || m_session != QLatin1String("default"))
+	{
+		return;
+	}
+
+	const QList<MainWindow*> windows = Application::getInstance()->getWindows();
+	SessionSummary summary;
+	summary.path = m_session;
+	summary.title = (m_summaries.contains(m_session) ? m_summaries[m_session].title : tr("Default"));
+	summary.modified = QFileInfo(getSessionPath(m_session)).lastModified();
+
+	for (int i = 0; i < windows.count(); ++i)
+	{
+		WindowsManager *manager = windows.at(i)->getWindowsManager();
+		int tabs = 0;
+
+		for (int j = 0; j < manager->getWindowCount(); ++j)
+		{
+			Window *window = manager->getWindow(j);
+
+			if (window && !window->isPrivate())
+			{
+				++tabs;
+			}
+		}
+
+		if (tabs > 0)
+		{
+			++summary.windows;
+
+			summary.tabs += tabs;
+		}
+	}
+
+	m_summaries[m_session] = summary;
+}
+
+void SessionsManager::setJournalLayout(SessionWriter *writer)
+{
+	const QList<MainWindow*> windows = Application::getInstance()->getWindows();
+	QList<SessionMainWindow> layoutWindows;
+	QList<QList<qint64> > layoutIdentifiers;
+
+	for (int i = 0; i < windows.count(); ++i)
+	{
+		WindowsManager *manager = windows.at(i)->getWindowsManager();
+		Window *activeWindow = manager->getWindow();
+		SessionMainWindow layout;
+		layout.geometry = windows.at(i)->saveGeometry();
+		layout.state = windows.at(i)->saveState();
+		layout.index = 0;
+
+		QList<qint64> identifiers;
+
+		for (int j = 0; j < manager->getWindowCount(); ++j)
+		{
+			Window *window = manager->getWindow(j);
+
+			if (window && !window->isPrivate())
+			{
+				if (window == activeWindow)
+				{
+					layout.index = identifiers.count();
+				}
+
+				identifiers.append(window->getIdentifier());
+			}
+		}
+
+		layoutWindows.append(layout);
+		layoutIdentifiers.append(identifiers);
+	}
+
+	writer->setJournalLayout(layoutWindows, layoutIdentifiers);
+}
+
+void SessionsManager::handleSessionsChanged()
+{
+	m_areSummariesValid = false;
+}
+
+void SessionsManager::handleSessionWritten(qint64 elapsed, bool isSnapshot, bool isSuccessful)
+{
+	if (!isSuccessful)
+	{
+		m_journalRecords = -1;
+
+		Console::addMessage(tr("Failed to save session"), OtherMessageCategory, ErrorMessageLevel);
+	}
+	else
+	{
+		updateSessionSummary();
+	}
+
+	const int limits[] = {5, 10, 25, 50, 100, 250, 500, 1000};
+	int bucket = 0;
+
+	while (bucket < 8 && elapsed >= limits[bucket])
+	{
+		++bucket;
+	}
+
+	++m_saveLatencies[bucket];
+	++m_savesAmount;
+
+	if (elapsed >= 1000)
+	{
+		Console::addMessage(tr("Saving session took %1 ms").arg(elapsed), OtherMessageCategory, WarningMessageLevel);
+	}
+
+	if (m_savesAmount % 50 == 0)
+	{
+		QStringList histogram;
+
+		for (int i = 0; i < 8; ++i)
+		{
+			histogram.append(QStringLiteral("<%1 ms: %2").arg(limits[i]).arg(m_saveLatencies.at(i)));
+		}
+
+		histogram.append(QStringLiteral(">=1000 ms: %1").arg(m_saveLatencies.at(8)));
+
+		Console::addMessage(tr("Session save latency after %1 saves (last was %2): %3").arg(m_savesAmount).arg(isSnapshot ? tr("snapshot") : tr("journal")).arg(histogram.join(QLatin1String(", "))), OtherMessageCategory, LogMessageLevel);
+	}
+}
+
+void SessionsManager::replayJournal(SessionInformation *session)
+{
+	QFile file(getJournalPath());
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		return;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_2);
+
+	quint32 magic;
+	QDateTime snapshotTime;
+
+	stream >> magic >> snapshotTime;
+
+	if (magic != 0x4F534A31 || snapshotTime != QFileInfo(getSessionPath(QLatin1String("default"))).lastModified())
+	{
+		return;
+	}
+
+	QHash<qint64, SessionWindow> windows;
+	QList<SessionMainWindow> layouts;
+	QList<QList<qint64> > layoutsWindows;
+	bool isBase = true;
+
+	while (!stream.atEnd())
+	{
+		quint8 type;
+
+		stream >> type;
+
+		if (type == LayoutJournalRecord)
+		{
+			QList<SessionMainWindow> newLayouts;
+			QList<QList<qint64> > newLayoutsWindows;
+			qint32 amount;
+
+			stream >> amount;
+
+			for (qint32 i = 0; i < amount; ++i)
+			{
+				SessionMainWindow layout;
+				QList<qint64> identifiers;
+				qint32 index;
+
+				stream >> layout.geometry >> layout.state >> index >> identifiers;
+
+				layout.index = index;
+
+				if (isBase)
+				{
+					for (int j = 0; j < identifiers.count(); ++j)
+					{
+						if (i < session->windows.count() && j < session->windows.at(i).windows.count())
+						{
+							windows[identifiers.at(j)] = session->windows.at(i).windows.at(j);
+						}
+					}
+				}
+
+				newLayouts.append(layout);
+				newLayoutsWindows.append(identifiers);
+			}
+
+			if (stream.status() != QDataStream::Ok)
+			{
+				break;
+			}
+
+			layouts = newLayouts;
+			layoutsWindows = newLayoutsWindows;
+			isBase = false;
+		}
+		else if (type == WindowJournalRecord && !isBase)
+		{
+			qint64 identifier;
+
+			stream >> identifier;
+
+			const SessionWindow window = readSessionWindow(stream);
+
+			if (stream.status() != QDataStream::Ok)
+			{
+				break;
+			}
+
+			windows[identifier] = window;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	if (isBase)
+	{
+		return;
+	}
+
+	session->windows.clear();
+	session->clean = false;
+
+	for (int i = 0; i < layouts.count(); ++i)
+	{
+		SessionMainWindow mainWindow = layouts.at(i);
+
+		for (int j = 0; j < layoutsWindows.at(i).count(); ++j)
+		{
+			if (windows.contains(layoutsWindows.at(i).at(j)))
+			{
+				mainWindow.windows.append(windows[layoutsWindows.at(i).at(j)]);
+			}
+			else if (j < layouts.at(i).index)
+			{
+				--mainWindow.index;
+			}
+		}
+
+		if (!mainWindow.windows.isEmpty())
+		{
+			session->windows.append(mainWindow);
+		}
+	}
+}
+
+SessionWindow SessionsManager::readSessionWindow(QDataStream &stream)
+{
+	SessionWindow window;
+	qint32 group;
+	qint32 index;
+	qint32 reloadTime;
+	qint32 amount;
+
+	stream >> window.searchEngine >> window.userAgent >> group >> index >> reloadTime >> window.pinned >> amount;
+
+	window.group = group;
+	window.index = index;
+	window.reloadTime = reloadTime;
+
+	for (qint32 i = 0; i < amount; ++i)
 	{
-		m_isDirty = true;
+		WindowHistoryEntry entry;
+		qint32 zoom;
+
+		stream >> entry.url >> entry.title >> entry.position >> zoom;
+
+		if (stream.status() != QDataStream::Ok)
+		{
+			break;
+		}
 
-		m_instance->scheduleSave();
+		entry.zoom = zoom;
+
+		window.history.append(entry);
 	}
+
+	return window;
 }
 
 void SessionsManager::removeStoredUrl(const QString &url)
@@ -169,45 +681,225 @@ QString SessionsManager::getProfilePath()
 	return m_profilePath;
 }
 
+QString SessionsManager::getJournalPath()
+{
+	return m_profilePath + QLatin1String("/sessions/default.journal");
+}
+
 QString SessionsManager::getSessionPath(const QString &path, bool bound)
 {
 	QString cleanPath = path;
 
 	if (cleanPath.isEmpty())
 	{
-		cleanPath = QLatin1String("default.ini");
+		cleanPath = QLatin1String("default.dat");
 	}
 	else
 	{
-		if (!cleanPath.endsWith(QLatin1String(".ini")))
-		{
-			cleanPath += QLatin1String(".ini");
-		}
-
 		if (bound)
 		{
 			cleanPath = cleanPath.replace(QLatin1Char('/'), QString()).replace(QLatin1Char('\\'), QString());
 		}
 		else if (QFileInfo(cleanPath).isAbsolute())
 		{
-			return cleanPath;
+			return (cleanPath.endsWith(QLatin1String(".ini")) || cleanPath.endsWith(QLatin1String(".dat")) ? cleanPath : (cleanPath + QLatin1String(".dat")));
+		}
+
+		if (cleanPath.endsWith(QLatin1String(".ini")))
+		{
+			cleanPath.chop(4);
+		}
+
+		if (!cleanPath.endsWith(QLatin1String(".dat")))
+		{
+			cleanPath += QLatin1String(".dat");
 		}
 	}
 
 	return m_profilePath + QLatin1String("/sessions/") + cleanPath;
 }
 
-SessionInformation SessionsManager::getSession(const QString &path)
+QString SessionsManager::getLegacySessionPath(const QString &path)
 {
-	const QString sessionPath = getSessionPath(path);
-	QSettings sessionData(sessionPath, QSettings::IniFormat);
-	sessionData.setIniCodec("UTF-8");
+	QString legacyPath = getSessionPath(path);
+
+	if (legacyPath.endsWith(QLatin1String(".dat")))
+	{
+		legacyPath.chop(4);
+		legacyPath += QLatin1String(".ini");
+	}
+
+	return legacyPath;
+}
 
+SessionInformation SessionsManager::getSession(const QString &path)
+{
 	SessionInformation session;
 	session.path = path;
-	session.title = sessionData.value(QLatin1String("Session/title"), ((path == QLatin1String("default")) ? tr("Default") : tr("(Untitled)"))).toString();
-	session.index = (sessionData.value(QLatin1String("Session/index"), 1).toInt() - 1);
-	session.clean = sessionData.value(QLatin1String("Session/clean"), true).toBool();
+	session.index = 0;
+
+	QFile file(getSessionPath(path));
+
+	if (!file.exists())
+	{
+		file.setFileName(getLegacySessionPath(path));
+	}
+
+	if (file.open(QIODevice::ReadOnly))
+	{
+		QDataStream stream(&file);
+		stream.setVersion(QDataStream::Qt_5_2);
+
+		quint32 magic;
+
+		stream >> magic;
+
+		if (magic == 0x4F535331)
+		{
+			readSession(stream, &session);
+		}
+		else
+		{
+			file.close();
+
+			readLegacySession(file.fileName(), &session);
+		}
+	}
+
+	if (session.title.isEmpty())
+	{
+		session.title = ((path == QLatin1String("default")) ? tr("Default") : tr("(Untitled)"));
+	}
+
+	if (path == QLatin1String("default"))
+	{
+		replayJournal(&session);
+	}
+
+	return session;
+}
+
+SessionSummary SessionsManager::readSessionSummary(const QString &path)
+{
+	SessionSummary summary;
+	summary.path = path;
+
+	QFile file(getSessionPath(path));
+
+	if (!file.exists())
+	{
+		file.setFileName(getLegacySessionPath(path));
+	}
+
+	summary.modified = QFileInfo(file).lastModified();
+
+	if (file.open(QIODevice::ReadOnly))
+	{
+		QDataStream stream(&file);
+		stream.setVersion(QDataStream::Qt_5_2);
+
+		quint32 magic;
+		quint16 version;
+
+		stream >> magic >> version;
+
+		if (magic == 0x4F535331 && version == 2)
+		{
+			bool clean;
+			qint32 tabs;
+			qint32 windows;
+
+			stream >> summary.title >> clean >> tabs >> windows;
+
+			summary.tabs = tabs;
+			summary.windows = windows;
+		}
+		else
+		{
+			file.close();
+
+			const SessionInformation session = getSession(path);
+
+			summary.title = session.title;
+			summary.windows = session.windows.count();
+
+			for (int i = 0; i < session.windows.count(); ++i)
+			{
+				summary.tabs += session.windows.at(i).windows.count();
+			}
+		}
+	}
+
+	if (summary.title.isEmpty())
+	{
+		summary.title = ((path == QLatin1String("default")) ? tr("Default") : tr("(Untitled)"));
+	}
+
+	return summary;
+}
+
+void SessionsManager::readSession(QDataStream &stream, SessionInformation *session)
+{
+	quint16 version;
+	qint32 amount;
+
+	stream >> version;
+
+	if (version < 1 || version > 2)
+	{
+		return;
+	}
+
+	stream >> session->title >> session->clean;
+
+	if (version > 1)
+	{
+		qint32 tabs;
+
+		stream >> tabs;
+	}
+
+	stream >> amount;
+
+	for (qint32 i = 0; i < amount; ++i)
+	{
+		SessionMainWindow sessionEntry;
+		qint32 index;
+		qint32 windows;
+
+		stream >> sessionEntry.geometry >> sessionEntry.state >> index >> windows;
+
+		sessionEntry.index = index;
+
+		for (qint32 j = 0; j < windows; ++j)
+		{
+			const SessionWindow sessionWindow = readSessionWindow(stream);
+
+			if (stream.status() != QDataStream::Ok)
+			{
+				break;
+			}
+
+			sessionEntry.windows.append(sessionWindow);
+		}
+
+		if (stream.status() != QDataStream::Ok)
+		{
+			break;
+		}
+
+		session->windows.append(sessionEntry);
+	}
+}
+
+void SessionsManager::readLegacySession(const QString &path, SessionInformation *session)
+{
+	QSettings sessionData(path, QSettings::IniFormat);
+	sessionData.setIniCodec("UTF-8");
+
+	session->title = sessionData.value(QLatin1String("Session/title")).toString();
+	session->index = (sessionData.value(QLatin1String("Session/index"), 1).toInt() - 1);
+	session->clean = sessionData.value(QLatin1String("Session/clean"), true).toBool();
 
 	const int windows = sessionData.value(QLatin1String("Session/windows"), 0).toInt();
 	const int defaultZoom = SettingsManager::getValue(QLatin1String("Content/DefaultZoom")).toInt();
@@ -246,10 +938,42 @@ SessionInformation SessionsManager::getSession(const QString &path)
 			sessionEntry.windows.append(sessionWindow);
 		}
 
-		session.windows.append(sessionEntry);
+		session->windows.append(sessionEntry);
 	}
+}
 
-	return session;
+QString SessionsManager::readSessionTitle(const QString &path, const QString &legacyPath)
+{
+	QFile file(path);
+
+	if (!file.exists())
+	{
+		QSettings sessionData(legacyPath, QSettings::IniFormat);
+		sessionData.setIniCodec("UTF-8");
+
+		return sessionData.value(QLatin1String("Session/title")).toString();
+	}
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		return QString();
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_2);
+
+	quint32 magic;
+	quint16 version;
+	QString title;
+
+	stream >> magic >> version;
+
+	if (magic == 0x4F535331 && (version == 1 || version == 2))
+	{
+		stream >> title;
+	}
+
+	return title;
 }
 
 QList<MainWindow*> SessionsManager::getWindows()
@@ -261,10 +985,9 @@ QStringList SessionsManager::getClosedWindows()
 {
 	QStringList closedWindows;
 
-	for (int i = 0; i < m_closedWindows.count(); ++i)
+	for (int i = 0; i < m_closedWindows->getCount(); ++i)
 	{
-		const SessionMainWindow window = m_closedWindows.at(i);
-		const QString title = window.windows.value(window.index, SessionWindow()).getTitle();
+		const QString title = m_closedWindows->getInformation(i).title;
 
 		closedWindows.append(title.isEmpty() ? tr("(Untitled)") : title);
 	}
@@ -272,13 +995,64 @@ QStringList SessionsManager::getClosedWindows()
 	return closedWindows;
 }
 
+QList<SessionSummary> SessionsManager::getSessionSummaries()
+{
+	const QString sessionsPath = m_profilePath + QLatin1String("/sessions/");
+
+	if (m_instance->m_sessionsWatcher->directories().isEmpty() && QFile::exists(sessionsPath))
+	{
+		m_instance->m_sessionsWatcher->addPath(sessionsPath);
+
+		m_areSummariesValid = false;
+	}
+
+	if (!m_areSummariesValid)
+	{
+		const QStringList sessions = getSessions();
+		QHash<QString, SessionSummary> summaries;
+
+		for (int i = 0; i < sessions.count(); ++i)
+		{
+			const QString path = sessions.at(i);
+			QFileInfo fileInfo(getSessionPath(path));
+
+			if (!fileInfo.exists())
+			{
+				fileInfo.setFile(getLegacySessionPath(path));
+			}
+
+			if (m_summaries.contains(path) && m_summaries[path].modified == fileInfo.lastModified())
+			{
+				summaries[path] = m_summaries[path];
+			}
+			else
+			{
+				summaries[path] = readSessionSummary(path);
+			}
+		}
+
+		m_summaries = summaries;
+		m_areSummariesValid = true;
+
+		updateSessionSummary();
+	}
+
+	return m_summaries.values();
+}
+
 QStringList SessionsManager::getSessions()
 {
-	QStringList entries = QDir(m_profilePath + QLatin1String("/sessions/")).entryList(QStringList(QLatin1String("*.ini")), QDir::Files);
+	const QStringList files = QDir(m_profilePath + QLatin1String("/sessions/")).entryList(QStringList(QLatin1String("*.dat")) << QLatin1String("*.ini"), QDir::Files);
+	QStringList entries;
 
-	for (int i = 0; i < entries.count(); ++i)
+	for (int i = 0; i < files.count(); ++i)
 	{
-		entries[i] = QFileInfo(entries.at(i)).completeBaseName();
+		const QString entry = QFileInfo(files.at(i)).completeBaseName();
+
+		if (!entries.contains(entry))
+		{
+			entries.append(entry);
+		}
 	}
 
 	if (!m_session.isEmpty() && !entries.contains(m_session))
@@ -303,9 +1077,9 @@ bool SessionsManager::restoreClosedWindow(int index)
 		index = 0;
 	}
 
-	Application::getInstance()->createWindow(false, false, m_closedWindows.value(index, SessionMainWindow()));
+	Application::getInstance()->createWindow(false, false, m_closedWindows->getMainWindow(index));
 
-	m_closedWindows.removeAt(index);
+	m_closedWindows->removeWindow(index);
 
 	emit m_instance->closedWindowsChanged();
 
@@ -344,11 +1118,11 @@ bool SessionsManager::restoreSession(const SessionInformation &session, MainWind
 	return true;
 }
 
-bool SessionsManager::saveSession(const QString &path, const QString &title, MainWindow *window, bool clean)
+SessionWriter* SessionsManager::createWriter(const QString &path, const QString &title, MainWindow *window, bool clean)
 {
 	if (m_isPrivate && path.isEmpty())
 	{
-		return false;
+		return NULL;
 	}
 
 	QList<MainWindow*> windows;
@@ -364,111 +1138,122 @@ bool SessionsManager::saveSession(const QString &path, const QString &title, Mai
 
 	if (windows.isEmpty())
 	{
-		return false;
+		return NULL;
 	}
 
 	QDir().mkpath(m_profilePath + QLatin1String("/sessions/"));
 
 	const QString sessionPath = getSessionPath(path);
-	QString sessionTitle = title;
+	const QString sessionName = QFileInfo(sessionPath).completeBaseName();
+	SessionInformation session;
+	session.path = path;
+	session.title = title;
+	session.clean = clean;
 
 	if (title.isEmpty())
 	{
-		QSettings sessionData(sessionPath, QSettings::IniFormat);
-		sessionData.setIniCodec("UTF-8");
-
-		sessionTitle = sessionData.value(QLatin1String("Session/title")).toString();;
+		session.title = (m_summaries.contains(sessionName) ? m_summaries[sessionName].title : readSessionTitle(sessionPath, getLegacySessionPath(path)));
 	}
 
-	QSaveFile file(sessionPath);
-
-	if (!file.open(QIODevice::WriteOnly))
+	for (int i = 0; i < windows.count(); ++i)
 	{
-		return false;
+		SessionMainWindow sessionEntry = windows.at(i)->getWindowsManager()->getSession();
+		sessionEntry.geometry = windows.at(i)->saveGeometry();
+		sessionEntry.state = windows.at(i)->saveState();
+
+		session.windows.append(sessionEntry);
 	}
 
-	const QString defaultSearchEngine = SettingsManager::getValue(QLatin1String("Search/DefaultSearchEngine")).toString();
-	const QString defaultUserAgent = SettingsManager::getValue(QLatin1String("Network/UserAgent")).toString();
-	QTextStream stream(&file);
-	stream.setCodec("UTF-8");
-	stream << QLatin1String("[Session]\n");
-	stream << Utils::formatConfigurationEntry(QLatin1String("title"), sessionTitle, true);
+	SessionWriter *writer = new SessionWriter();
+	writer->setSession(sessionPath, getLegacySessionPath(path), session);
 
-	if (!clean)
+	if (!window && sessionPath == getSessionPath(QLatin1String("default")))
 	{
-		stream << QLatin1String("clean=false\n");
-	}
+		writer->setJournal(getJournalPath(), true);
 
-	stream << QLatin1String("windows=") << windows.count() << QLatin1Char('\n');
-	stream << QLatin1String("index=1\n\n");
+		setJournalLayout(writer);
 
-	for (int i = 0; i < windows.count(); ++i)
-	{
-		const SessionMainWindow sessionEntry = windows.at(i)->getWindowsManager()->getSession();
+		m_modifiedWindows.clear();
+		m_isLayoutModified = false;
+		m_journalRecords = (clean ? -1 : 0);
+	}
 
-		stream << QStringLiteral("[%1/Properties]\n").arg(i + 1);
-		stream << Utils::formatConfigurationEntry(QLatin1String("geometry"), windows.at(i)->saveGeometry().toBase64(), true);
-		stream << Utils::formatConfigurationEntry(QLatin1String("state"), windows.at(i)->saveState().toBase64(), true);
-		stream << QLatin1String("groups=0\n");
-		stream << QLatin1String("windows=") << sessionEntry.windows.count() << QLatin1Char('\n');
-		stream << QLatin1String("index=") << (sessionEntry.index + 1) << QLatin1String("\n\n");
+	return writer;
+}
 
-		for (int j = 0; j < sessionEntry.windows.count(); ++j)
-		{
-			stream << QStringLiteral("[%1/%2/Properties]\n").arg(i + 1).arg(j + 1);
+bool SessionsManager::saveSession(const QString &path, const QString &title, MainWindow *window, bool clean)
+{
+	SessionWriter *writer = createWriter(path, title, window, clean);
 
-			if (sessionEntry.windows.at(j).searchEngine != defaultSearchEngine)
-			{
-				stream << Utils::formatConfigurationEntry(QLatin1String("searchEngine"), sessionEntry.windows.at(j).searchEngine);
-			}
+	if (!writer)
+	{
+		return false;
+	}
 
-			if (sessionEntry.windows.at(j).userAgent != defaultUserAgent)
-			{
-				stream << Utils::formatConfigurationEntry(QLatin1String("userAgent"), sessionEntry.windows.at(j).userAgent, true);
-			}
+	m_instance->m_writerPool->waitForDone();
 
-			if (sessionEntry.windows.at(j).reloadTime != -1)
-			{
-				stream << Utils::formatConfigurationEntry(QLatin1String("reloadTime"), QString::number(sessionEntry.windows.at(j).reloadTime));
-			}
+	writer->run();
 
-			if (sessionEntry.windows.at(j).pinned)
-			{
-				stream << QLatin1String("pinned=true\n");
-			}
+	const bool isSuccessful = writer->isSuccessful();
 
-			stream << QLatin1String("history=") << sessionEntry.windows.at(j).history.count() << QLatin1Char('\n');
-			stream << QLatin1String("index=") << (sessionEntry.windows.at(j).index + 1) << QLatin1String("\n\n");
+	delete writer;
 
-			for (int k = 0; k < sessionEntry.windows.at(j).history.count(); ++k)
-			{
-				stream << QStringLiteral("[%1/%2/History/%3]\n").arg(i + 1).arg(j + 1).arg(k + 1);
-				stream << Utils::formatConfigurationEntry(QLatin1String("url"), sessionEntry.windows.at(j).history.at(k).url, true);
-				stream << Utils::formatConfigurationEntry(QLatin1String("title"), sessionEntry.windows.at(j).history.at(k).title, true);
-				stream << QLatin1String("position=") << sessionEntry.windows.at(j).history.at(k).position.x() << ',' << sessionEntry.windows.at(j).history.at(k).position.y() << QLatin1Char('\n');
-				stream << QLatin1String("zoom=") << sessionEntry.windows.at(j).history.at(k).zoom << QLatin1String("\n\n");
-			}
-		}
+	if (isSuccessful && !QFileInfo(path).isAbsolute())
+	{
+		const QString name = QFileInfo(getSessionPath(path)).completeBaseName();
+
+		m_summaries[name] = readSessionSummary(name);
 	}
 
-	return file.commit();
+	return isSuccessful;
 }
 
 bool SessionsManager::deleteSession(const QString &path)
 {
 	const QString cleanPath = getSessionPath(path, true);
+	QString legacyPath = cleanPath;
+	legacyPath.chop(4);
+	legacyPath += QLatin1String(".ini");
+
+	bool isRemoved = false;
+
+	if (QFile::exists(legacyPath))
+	{
+		isRemoved = QFile::remove(legacyPath);
+	}
 
 	if (QFile::exists(cleanPath))
 	{
-		return QFile::remove(cleanPath);
+		isRemoved = QFile::remove(cleanPath);
 	}
 
-	return false;
+	m_summaries.remove(QFileInfo(cleanPath).completeBaseName());
+
+	return isRemoved;
 }
 
 bool SessionsManager::moveSession(const QString &from, const QString &to)
 {
-	return QFile::rename(getSessionPath(from), getSessionPath(to));
+	bool isMoved = false;
+
+	if (QFile::exists(getSessionPath(from)))
+	{
+		isMoved = QFile::rename(getSessionPath(from), getSessionPath(to));
+	}
+	else
+	{
+		isMoved = QFile::rename(getLegacySessionPath(from), getLegacySessionPath(to));
+	}
+
+	if (isMoved && m_summaries.contains(from))
+	{
+		SessionSummary summary = m_summaries.take(from);
+		summary.path = to;
+
+		m_summaries[to] = summary;
+	}
+
+	return isMoved;
 }
 
 bool SessionsManager::isLastWindow()
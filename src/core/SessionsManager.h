@@ -23,8 +23,14 @@
 #include "SettingsManager.h"
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileSystemWatcher>
 #include <QtCore/QPoint>
 #include <QtCore/QPointer>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVector>
 
 namespace Otter
 {
@@ -100,6 +106,17 @@ struct SessionMainWindow
 	SessionMainWindow() : index(-1) {}
 };
 
+struct SessionSummary
+{
+	QString path;
+	QString title;
+	QDateTime modified;
+	int windows;
+	int tabs;
+
+	SessionSummary() : windows(0), tabs(0) {}
+};
+
 struct SessionInformation
 {
 	QString path;
@@ -111,7 +128,11 @@ struct SessionInformation
 	SessionInformation() : index(-1), clean(true) {}
 };
 
+class ClosedWindowsStore;
 class MainWindow;
+class SessionWriter;
+class TabHibernationPolicy;
+class Window;
 class WindowsManager;
 
 class SessionsManager : public QObject
@@ -119,12 +140,23 @@ class SessionsManager : public QObject
 	Q_OBJECT
 
 public:
+	enum JournalRecordType
+	{
+		UnknownJournalRecord = 0,
+		LayoutJournalRecord = 1,
+		WindowJournalRecord = 2
+	};
+
+	~SessionsManager();
+
 	static void createInstance(const QString &profilePath, const QString &cachePath, bool isPrivate = false, QObject *parent = NULL);
 	static void clearClosedWindows();
 	static void registerWindow(MainWindow *window);
 	static void storeClosedWindow(MainWindow *window);
 	static void markSessionModified();
+	static void markSessionModified(Window *window);
 	static void removeStoredUrl(const QString &url);
+	static void scheduleRestore(const QList<Window*> &windows);
 	static void setActiveWindow(MainWindow *window);
 	static SessionsManager* getInstance();
 	static WindowsManager* getWindowsManager();
@@ -133,9 +165,12 @@ public:
 	static QString getCachePath();
 	static QString getProfilePath();
 	static QString getSessionPath(const QString &path, bool bound = false);
+	static QString readSessionTitle(const QString &path, const QString &legacyPath);
 	static SessionInformation getSession(const QString &path);
+	static SessionWindow readSessionWindow(QDataStream &stream);
 	static QStringList getClosedWindows();
 	static QStringList getSessions();
+	static QList<SessionSummary> getSessionSummaries();
 	static QList<MainWindow*> getWindows();
 	static bool restoreClosedWindow(int index = -1);
 	static bool restoreSession(const SessionInformation &session, MainWindow *window = NULL, bool isPrivate = false);
@@ -149,11 +184,35 @@ public:
 protected:
 	explicit SessionsManager(QObject *parent = NULL);
 
+	bool eventFilter(QObject *object, QEvent *event);
+
 	void timerEvent(QTimerEvent *event);
 	void scheduleSave();
+	void restoreWindows();
+	static void saveJournal();
+	static void replayJournal(SessionInformation *session);
+	static void updateSessionSummary();
+	static void setJournalLayout(SessionWriter *writer);
+	static void readSession(QDataStream &stream, SessionInformation *session);
+	static void readLegacySession(const QString &path, SessionInformation *session);
+	static SessionSummary readSessionSummary(const QString &path);
+	static SessionWriter* createWriter(const QString &path, const QString &title, MainWindow *window, bool clean);
+	static QString getJournalPath();
+	static QString getLegacySessionPath(const QString &path);
+
+protected slots:
+	void handleSessionsChanged();
+	void handleRestoringWindowLoaded();
+	void handleSessionWritten(qint64 elapsed, bool isSnapshot, bool isSuccessful);
 
 private:
+	QThreadPool *m_writerPool;
+	QFileSystemWatcher *m_sessionsWatcher;
+	TabHibernationPolicy *m_hibernationPolicy;
+	QVector<int> m_saveLatencies;
+	int m_savesAmount;
 	int m_saveTimer;
+	int m_restoreTimer;
 
 	static SessionsManager *m_instance;
 	static QPointer<MainWindow> m_activeWindow;
@@ -161,13 +220,23 @@ private:
 	static QString m_cachePath;
 	static QString m_profilePath;
 	static QList<MainWindow*> m_windows;
-	static QList<SessionMainWindow> m_closedWindows;
+	static ClosedWindowsStore *m_closedWindows;
+	static QHash<qint64, QPointer<Window> > m_modifiedWindows;
+	static QHash<QString, SessionSummary> m_summaries;
+	static QList<QPointer<Window> > m_restoreQueue;
+	static QList<QPair<QPointer<Window>, qint64> > m_restoringWindows;
+	static QElapsedTimer m_interactionTimer;
+	static int m_restoreTotal;
+	static int m_journalRecords;
+	static bool m_areSummariesValid;
 	static bool m_isDirty;
+	static bool m_isLayoutModified;
 	static bool m_isPrivate;
 
 signals:
 	void closedWindowsChanged();
 	void requestedRemoveStoredUrl(QString url);
+	void restoreProgressChanged(int restored, int total);
 };
 
 }
@@ -21,7 +21,10 @@
 #include "SettingsManager.h"
 
 #include <QtCore/QFileInfo>
+#include <QtCore/QMetaEnum>
 #include <QtCore/QSettings>
+#include <QtCore/QTimerEvent>
+#include <QtNetwork/QHostAddress>
 
 namespace Otter
 {
@@ -29,10 +32,41 @@ namespace Otter
 SettingsManager* SettingsManager::m_instance = NULL;
 QString SettingsManager::m_globalPath;
 QString SettingsManager::m_overridePath;
-QHash<QString, QVariant> SettingsManager::m_defaults;
+QHash<QString, int> SettingsManager::m_identifiers;
+QStringList SettingsManager::m_options;
+QVector<QVariant> SettingsManager::m_defaults;
+QVector<SettingsManager::OptionType> SettingsManager::m_types;
+QHash<int, QVariant> SettingsManager::m_values;
+QHash<int, QList<QObject*> > SettingsManager::m_listeners;
+QHash<QObject*, QList<int> > SettingsManager::m_listenersOptions;
+QHash<QString, QList<QObject*> > SettingsManager::m_groupListeners;
+QHash<QObject*, QStringList> SettingsManager::m_listenersGroups;
+QHash<QString, QHash<QString, QVariant> > SettingsManager::m_overrides;
+QHash<QString, SettingsManager::OverridesSnapshot> SettingsManager::m_snapshots;
+quint64 SettingsManager::m_snapshotsCounter = 0;
+QDateTime SettingsManager::m_globalModified;
+QDateTime SettingsManager::m_overrideModified;
+bool SettingsManager::m_isGlobalModified = false;
+bool SettingsManager::m_isOverrideModified = false;
 
-SettingsManager::SettingsManager(QObject *parent) : QObject(parent)
+SettingsManager::SettingsManager(QObject *parent) : QObject(parent),
+	m_watcher(new QFileSystemWatcher(this)),
+	m_saveTimer(0)
 {
+	connect(m_watcher, SIGNAL(fileChanged(QString)), this, SLOT(handleFileChanged(QString)));
+}
+
+SettingsManager::~SettingsManager()
+{
+	if (m_isGlobalModified)
+	{
+		saveGlobal();
+	}
+
+	if (m_isOverrideModified)
+	{
+		saveOverrides();
+	}
 }
 
 void SettingsManager::createInstance(const QString &path, QObject *parent)
@@ -42,33 +76,435 @@ void SettingsManager::createInstance(const QString &path, QObject *parent)
 		m_instance = new SettingsManager(parent);
 		m_globalPath = path + QLatin1String("/otter.conf");
 		m_overridePath = path + QLatin1String("/override.ini");
+
+		const QMetaEnum enumerator = m_instance->metaObject()->enumerator(m_instance->metaObject()->indexOfEnumerator("OptionIdentifier"));
+
+		for (int i = 0; i < enumerator.keyCount(); ++i)
+		{
+			QString name = QString::fromLatin1(enumerator.key(i));
+			name.chop(6);
+			name.replace(name.indexOf(QLatin1Char('_')), 1, QLatin1Char('/'));
+
+			createOptionIdentifier(name);
+		}
+
+		loadGlobal();
+		loadOverrides();
+
+		if (QFile::exists(m_globalPath))
+		{
+			m_instance->m_watcher->addPath(m_globalPath);
+		}
+
+		if (QFile::exists(m_overridePath))
+		{
+			m_instance->m_watcher->addPath(m_overridePath);
+		}
+	}
+}
+
+void SettingsManager::loadDefaults(const QString &path)
+{
+	QSettings defaults(path, QSettings::IniFormat);
+	const QStringList keys = defaults.allKeys();
+	const QLatin1String suffix("/value");
+
+	m_identifiers.reserve(m_identifiers.count() + (keys.count() / 2));
+	m_options.reserve(m_options.count() + (keys.count() / 2));
+	m_defaults.reserve(m_defaults.count() + (keys.count() / 2));
+	m_types.reserve(m_types.count() + (keys.count() / 2));
+
+	for (int i = 0; i < keys.count(); ++i)
+	{
+		if (!keys.at(i).endsWith(suffix))
+		{
+			continue;
+		}
+
+		const QString key = keys.at(i).left(keys.at(i).length() - suffix.size());
+		const QString type = defaults.value(key + QLatin1String("/type")).toString();
+		const int identifier = createOptionIdentifier(key);
+
+		if (type == QLatin1String("bool"))
+		{
+			m_types[identifier] = BooleanType;
+		}
+		else if (type == QLatin1String("color"))
+		{
+			m_types[identifier] = ColorType;
+		}
+		else if (type == QLatin1String("enumeration"))
+		{
+			m_types[identifier] = EnumerationType;
+		}
+		else if (type == QLatin1String("font"))
+		{
+			m_types[identifier] = FontType;
+		}
+		else if (type == QLatin1String("integer"))
+		{
+			m_types[identifier] = IntegerType;
+		}
+		else if (type == QLatin1String("path"))
+		{
+			m_types[identifier] = PathType;
+		}
+		else if (type == QLatin1String("string"))
+		{
+			m_types[identifier] = StringType;
+		}
+
+		m_defaults[identifier] = convertValue(identifier, defaults.value(keys.at(i)));
+
+		if (m_values.contains(identifier))
+		{
+			m_values[identifier] = convertValue(identifier, m_values[identifier]);
+		}
+	}
+}
+
+void SettingsManager::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == m_saveTimer)
+	{
+		killTimer(m_saveTimer);
+
+		m_saveTimer = 0;
+
+		if (m_isGlobalModified)
+		{
+			saveGlobal();
+		}
+
+		if (m_isOverrideModified)
+		{
+			saveOverrides();
+		}
+
+		const QStringList files = m_watcher->files();
+
+		if (!files.contains(m_globalPath) && QFile::exists(m_globalPath))
+		{
+			m_watcher->addPath(m_globalPath);
+		}
+
+		if (!files.contains(m_overridePath) && QFile::exists(m_overridePath))
+		{
+			m_watcher->addPath(m_overridePath);
+		}
+	}
+}
+
+void SettingsManager::scheduleSave()
+{
+	if (m_saveTimer == 0)
+	{
+		m_saveTimer = startTimer(1000);
+	}
+}
+
+void SettingsManager::handleFileChanged(const QString &path)
+{
+	if (!m_watcher->files().contains(path) && QFile::exists(path))
+	{
+		m_watcher->addPath(path);
+	}
+
+	if (path == m_overridePath)
+	{
+		if (!m_isOverrideModified && QFileInfo(m_overridePath).lastModified() != m_overrideModified)
+		{
+			loadOverrides();
+		}
+
+		return;
+	}
+
+	if (path != m_globalPath || m_isGlobalModified || QFileInfo(m_globalPath).lastModified() == m_globalModified)
+	{
+		return;
+	}
+
+	const QHash<int, QVariant> values = m_values;
+
+	loadGlobal();
+
+	for (int i = 0; i < m_options.count(); ++i)
+	{
+		const QVariant value = getValue(i);
+
+		if (values.value(i, getDefaultValue(i)) != value)
+		{
+			notifyListeners(i, value);
+		}
+	}
+}
+
+void SettingsManager::handleListenerDestroyed(QObject *object)
+{
+	removeListener(object);
+}
+
+void SettingsManager::loadGlobal()
+{
+	QSettings settings(m_globalPath, QSettings::IniFormat);
+	const QStringList keys = settings.allKeys();
+
+	m_values.clear();
+
+	for (int i = 0; i < keys.count(); ++i)
+	{
+		const int identifier = createOptionIdentifier(keys.at(i));
+
+		m_values[identifier] = convertValue(identifier, settings.value(keys.at(i)));
+	}
+
+	m_globalModified = QFileInfo(m_globalPath).lastModified();
+}
+
+void SettingsManager::loadOverrides()
+{
+	QSettings settings(m_overridePath, QSettings::IniFormat);
+	const QStringList hosts = settings.childGroups();
+
+	m_overrides.clear();
+	m_snapshots.clear();
+
+	for (int i = 0; i < hosts.count(); ++i)
+	{
+		settings.beginGroup(hosts.at(i));
+
+		const QStringList keys = settings.allKeys();
+		QHash<QString, QVariant> overrides;
+
+		for (int j = 0; j < keys.count(); ++j)
+		{
+			overrides[keys.at(j)] = settings.value(keys.at(j));
+		}
+
+		if (!overrides.isEmpty())
+		{
+			m_overrides[hosts.at(i)] = overrides;
+		}
+
+		settings.endGroup();
+	}
+
+	m_overrideModified = QFileInfo(m_overridePath).lastModified();
+}
+
+void SettingsManager::saveGlobal()
+{
+	QSettings settings(m_globalPath, QSettings::IniFormat);
+	settings.clear();
+
+	QHash<int, QVariant>::const_iterator iterator;
+
+	for (iterator = m_values.constBegin(); iterator != m_values.constEnd(); ++iterator)
+	{
+		settings.setValue(m_options.at(iterator.key()), iterator.value());
+	}
+
+	settings.sync();
+
+	m_globalModified = QFileInfo(m_globalPath).lastModified();
+	m_isGlobalModified = false;
+}
+
+void SettingsManager::saveOverrides()
+{
+	QSettings settings(m_overridePath, QSettings::IniFormat);
+	settings.clear();
+
+	QHash<QString, QHash<QString, QVariant> >::const_iterator hostsIterator;
+
+	for (hostsIterator = m_overrides.constBegin(); hostsIterator != m_overrides.constEnd(); ++hostsIterator)
+	{
+		settings.beginGroup(hostsIterator.key());
+
+		QHash<QString, QVariant>::const_iterator iterator;
+
+		for (iterator = hostsIterator.value().constBegin(); iterator != hostsIterator.value().constEnd(); ++iterator)
+		{
+			settings.setValue(iterator.key(), iterator.value());
+		}
+
+		settings.endGroup();
+	}
+
+	settings.sync();
+
+	m_overrideModified = QFileInfo(m_overridePath).lastModified();
+	m_isOverrideModified = false;
+}
+
+void SettingsManager::notifyListeners(int identifier, const QVariant &value)
+{
+	const QString option = m_options.at(identifier);
+
+	emit m_instance->valueChanged(option, value);
+
+	QList<QObject*> listeners = m_listeners.value(identifier);
+	QHash<QString, QList<QObject*> >::const_iterator iterator;
+
+	for (iterator = m_groupListeners.constBegin(); iterator != m_groupListeners.constEnd(); ++iterator)
+	{
+		if (option.startsWith(iterator.key()))
+		{
+			for (int i = 0; i < iterator.value().count(); ++i)
+			{
+				if (!listeners.contains(iterator.value().at(i)))
+				{
+					listeners.append(iterator.value().at(i));
+				}
+			}
+		}
+	}
+
+	for (int i = 0; i < listeners.count(); ++i)
+	{
+		if (m_listenersOptions.contains(listeners.at(i)) || m_listenersGroups.contains(listeners.at(i)))
+		{
+			QMetaObject::invokeMethod(listeners.at(i), "optionChanged", Qt::DirectConnection, Q_ARG(int, identifier), Q_ARG(QVariant, value));
+		}
+	}
+}
+
+void SettingsManager::addListener(QObject *object, const QList<int> &identifiers)
+{
+	if (!object)
+	{
+		return;
+	}
+
+	if (!m_listenersOptions.contains(object) && !m_listenersGroups.contains(object))
+	{
+		connect(object, SIGNAL(destroyed(QObject*)), m_instance, SLOT(handleListenerDestroyed(QObject*)));
+	}
+
+	QList<int> &listenerOptions = m_listenersOptions[object];
+
+	for (int i = 0; i < identifiers.count(); ++i)
+	{
+		if (!listenerOptions.contains(identifiers.at(i)))
+		{
+			listenerOptions.append(identifiers.at(i));
+
+			m_listeners[identifiers.at(i)].append(object);
+		}
+	}
+}
+
+void SettingsManager::addGroupListener(QObject *object, const QString &group)
+{
+	if (!object)
+	{
+		return;
+	}
+
+	if (!m_listenersOptions.contains(object) && !m_listenersGroups.contains(object))
+	{
+		connect(object, SIGNAL(destroyed(QObject*)), m_instance, SLOT(handleListenerDestroyed(QObject*)));
+	}
+
+	const QString prefix = (group.endsWith(QLatin1Char('/')) ? group : (group + QLatin1Char('/')));
+
+	if (!m_listenersGroups[object].contains(prefix))
+	{
+		m_listenersGroups[object].append(prefix);
+
+		m_groupListeners[prefix].append(object);
 	}
 }
 
+void SettingsManager::removeListener(QObject *object)
+{
+	if (!m_listenersOptions.contains(object) && !m_listenersGroups.contains(object))
+	{
+		return;
+	}
+
+	const QList<int> identifiers = m_listenersOptions.take(object);
+
+	for (int i = 0; i < identifiers.count(); ++i)
+	{
+		m_listeners[identifiers.at(i)].removeAll(object);
+
+		if (m_listeners[identifiers.at(i)].isEmpty())
+		{
+			m_listeners.remove(identifiers.at(i));
+		}
+	}
+
+	const QStringList groups = m_listenersGroups.take(object);
+
+	for (int i = 0; i < groups.count(); ++i)
+	{
+		m_groupListeners[groups.at(i)].removeAll(object);
+
+		if (m_groupListeners[groups.at(i)].isEmpty())
+		{
+			m_groupListeners.remove(groups.at(i));
+		}
+	}
+
+	disconnect(object, SIGNAL(destroyed(QObject*)), m_instance, SLOT(handleListenerDestroyed(QObject*)));
+}
+
 void SettingsManager::registerOption(const QString &key)
 {
-	QSettings(m_globalPath, QSettings::IniFormat).remove(key);
+	const int identifier = createOptionIdentifier(key);
+
+	if (m_values.remove(identifier) > 0)
+	{
+		m_isGlobalModified = true;
+
+		m_instance->scheduleSave();
+	}
 
-	emit m_instance->valueChanged(key, getValue(key));
+	notifyListeners(identifier, getValue(identifier));
 }
 
 void SettingsManager::removeOverride(const QUrl &url, const QString &key)
 {
+	const QString host = getHost(url);
+
+	if (!m_overrides.contains(host))
+	{
+		return;
+	}
+
 	if (key.isEmpty())
 	{
-		QSettings(m_overridePath, QSettings::IniFormat).remove(url.isLocalFile() ? QLatin1String("localhost") : url.host());
+		m_overrides.remove(host);
 	}
 	else
 	{
-		QSettings(m_overridePath, QSettings::IniFormat).remove((url.isLocalFile() ? QLatin1String("localhost") : url.host()) + QLatin1Char('/') + key);
+		if (m_overrides[host].remove(key) == 0)
+		{
+			return;
+		}
+
+		if (m_overrides[host].isEmpty())
+		{
+			m_overrides.remove(host);
+		}
 	}
+
+	m_snapshots.clear();
+
+	m_isOverrideModified = true;
+
+	m_instance->scheduleSave();
 }
 
 void SettingsManager::setDefaultValue(const QString &key, const QVariant &value)
 {
-	m_defaults[key] = value;
+	const int identifier = createOptionIdentifier(key);
 
-	emit m_instance->valueChanged(key, getValue(key));
+	m_defaults[identifier] = convertValue(identifier, value);
+
+	notifyListeners(identifier, getValue(identifier));
 }
 
 void SettingsManager::setValue(const QString &key, const QVariant &value, const QUrl &url)
@@ -77,21 +513,32 @@ void SettingsManager::setValue(const QString &key, const QVariant &value, const
 	{
 		if (value.isNull())
 		{
-			QSettings(m_overridePath, QSettings::IniFormat).remove((url.isLocalFile() ? QLatin1String("localhost") : url.host()) + QLatin1Char('/') + key);
+			removeOverride(url, key);
 		}
 		else
 		{
-			QSettings(m_overridePath, QSettings::IniFormat).setValue((url.isLocalFile() ? QLatin1String("localhost") : url.host()) + QLatin1Char('/') + key, value);
+			m_overrides[getHost(url)][key] = value;
+
+			m_snapshots.clear();
+
+			m_isOverrideModified = true;
+
+			m_instance->scheduleSave();
 		}
 
 		return;
 	}
 
-	if (getValue(key) != value)
+	const int identifier = createOptionIdentifier(key);
+
+	if (getValue(identifier) != value)
 	{
-		QSettings(m_globalPath, QSettings::IniFormat).setValue(key, value);
+		m_values[identifier] = convertValue(identifier, value);
+		m_isGlobalModified = true;
+
+		m_instance->scheduleSave();
 
-		emit m_instance->valueChanged(key, value);
+		notifyListeners(identifier, m_values[identifier]);
 	}
 }
 
@@ -100,31 +547,173 @@ SettingsManager* SettingsManager::getInstance()
 	return m_instance;
 }
 
+QString SettingsManager::getHost(const QUrl &url)
+{
+	return (url.isLocalFile() ? QLatin1String("localhost") : url.host());
+}
+
+QVariant SettingsManager::convertValue(int identifier, const QVariant &value)
+{
+	if (value.isNull())
+	{
+		return value;
+	}
+
+	switch (getOptionType(identifier))
+	{
+		case BooleanType:
+			return QVariant(value.toBool());
+		case IntegerType:
+			return QVariant(value.toInt());
+		default:
+			break;
+	}
+
+	return value;
+}
+
+QString SettingsManager::getOptionName(int identifier)
+{
+	return ((identifier >= 0 && identifier < m_options.count()) ? m_options.at(identifier) : QString());
+}
+
 QVariant SettingsManager::getDefaultValue(const QString &key)
 {
-	return m_defaults[key];
+	return getDefaultValue(getOptionIdentifier(key));
+}
+
+QVariant SettingsManager::getDefaultValue(int identifier)
+{
+	return ((identifier >= 0 && identifier < m_defaults.count()) ? m_defaults.at(identifier) : QVariant());
 }
 
 QVariant SettingsManager::getValue(const QString &key, const QUrl &url)
 {
-	if (!url.isEmpty())
+	if (!url.isEmpty() && !m_overrides.isEmpty())
 	{
-		return QSettings(m_overridePath, QSettings::IniFormat).value((url.isLocalFile() ? QLatin1String("localhost") : url.host()) + QLatin1Char('/') + key, getValue(key));
+		const QHash<QString, QVariant> overrides = getOverrides(url);
+		const QHash<QString, QVariant>::const_iterator value = overrides.constFind(key);
+
+		if (value != overrides.constEnd())
+		{
+			return value.value();
+		}
 	}
 
-	return QSettings(m_globalPath, QSettings::IniFormat).value(key, getDefaultValue(key));
+	return getValue(getOptionIdentifier(key));
 }
 
-bool SettingsManager::hasOverride(const QUrl &url, const QString &key)
+QVariant SettingsManager::getValue(int identifier)
 {
-	if (key.isEmpty())
+	const QHash<int, QVariant>::const_iterator value = m_values.constFind(identifier);
+
+	return ((value == m_values.constEnd()) ? getDefaultValue(identifier) : value.value());
+}
+
+QHash<QString, QVariant> SettingsManager::getOverrides(const QUrl &url)
+{
+	const QString host = getHost(url);
+	QHash<QString, OverridesSnapshot>::iterator snapshot = m_snapshots.find(host);
+
+	if (snapshot != m_snapshots.end())
 	{
-		return QSettings(m_overridePath, QSettings::IniFormat).childGroups().contains(url.isLocalFile() ? QLatin1String("localhost") : url.host());
+		snapshot.value().lastUsed = ++m_snapshotsCounter;
+
+		return snapshot.value().values;
 	}
-	else
+
+	QStringList domains;
+	const QString topLevelDomain = url.topLevelDomain();
+
+	if (!topLevelDomain.isEmpty() && host.endsWith(topLevelDomain) && !QHostAddress().setAddress(host))
 	{
-		return QSettings(m_overridePath, QSettings::IniFormat).contains((url.isLocalFile() ? QLatin1String("localhost") : url.host()) + QLatin1Char('/') + key);
+		const QStringList labels = host.left(host.length() - topLevelDomain.length()).split(QLatin1Char('.'), QString::SkipEmptyParts);
+
+		for (int i = (labels.count() - 1); i >= 0; --i)
+		{
+			domains.append(QLatin1String("*.") + QStringList(labels.mid(i)).join(QLatin1Char('.')) + topLevelDomain);
+		}
 	}
+
+	domains.append(host);
+
+	OverridesSnapshot newSnapshot;
+	newSnapshot.lastUsed = ++m_snapshotsCounter;
+
+	for (int i = 0; i < domains.count(); ++i)
+	{
+		const QHash<QString, QHash<QString, QVariant> >::const_iterator overrides = m_overrides.constFind(domains.at(i));
+
+		if (overrides == m_overrides.constEnd())
+		{
+			continue;
+		}
+
+		QHash<QString, QVariant>::const_iterator iterator;
+
+		for (iterator = overrides.value().constBegin(); iterator != overrides.value().constEnd(); ++iterator)
+		{
+			newSnapshot.values[iterator.key()] = iterator.value();
+		}
+	}
+
+	if (m_snapshots.count() >= 100)
+	{
+		QHash<QString, OverridesSnapshot>::iterator oldestSnapshot = m_snapshots.begin();
+
+		for (snapshot = m_snapshots.begin(); snapshot != m_snapshots.end(); ++snapshot)
+		{
+			if (snapshot.value().lastUsed < oldestSnapshot.value().lastUsed)
+			{
+				oldestSnapshot = snapshot;
+			}
+		}
+
+		m_snapshots.erase(oldestSnapshot);
+	}
+
+	m_snapshots[host] = newSnapshot;
+
+	return newSnapshot.values;
+}
+
+SettingsManager::OptionType SettingsManager::getOptionType(int identifier)
+{
+	return ((identifier >= 0 && identifier < m_types.count()) ? m_types.at(identifier) : UnknownType);
+}
+
+int SettingsManager::getOptionIdentifier(const QString &key)
+{
+	return m_identifiers.value(key, -1);
+}
+
+int SettingsManager::createOptionIdentifier(const QString &key)
+{
+	const QHash<QString, int>::const_iterator identifier = m_identifiers.constFind(key);
+
+	if (identifier != m_identifiers.constEnd())
+	{
+		return identifier.value();
+	}
+
+	m_identifiers[key] = m_options.count();
+	m_options.append(key);
+	m_defaults.append(QVariant());
+	m_types.append(UnknownType);
+
+	return (m_options.count() - 1);
+}
+
+bool SettingsManager::hasOverride(const QUrl &url, const QString &key)
+{
+	const QHash<QString, QHash<QString, QVariant> >::const_iterator overrides = m_overrides.constFind(getHost(url));
+
+	if (overrides == m_overrides.constEnd())
+	{
+		return false;
+	}
+
+	return (key.isEmpty() || overrides.value().contains(key));
 }
 
 }
@@ -21,9 +21,12 @@
 #ifndef OTTER_SETTINGSMANAGER_H
 #define OTTER_SETTINGSMANAGER_H
 
+#include <QtCore/QDateTime>
+#include <QtCore/QFileSystemWatcher>
 #include <QtCore/QObject>
 #include <QtCore/QUrl>
 #include <QtCore/QVariant>
+#include <QtCore/QVector>
 
 namespace Otter
 {
@@ -31,26 +34,225 @@ namespace Otter
 class SettingsManager : public QObject
 {
 	Q_OBJECT
+	Q_ENUMS(OptionIdentifier)
 
 public:
+	enum OptionIdentifier
+	{
+		AddressField_HostLookupTimeoutOption = 0,
+		AddressField_PasteAndGoOnMiddleClickOption,
+		AddressField_SelectAllOnFocusOption,
+		AddressField_ShowBookmarkIconOption,
+		AddressField_ShowLoadPluginsIconOption,
+		AddressField_ShowUrlIconOption,
+		AddressField_SuggestBookmarksOption,
+		Backends_WebOption,
+		Browser_ActionMacrosProfilesOrderOption,
+		Browser_AlwaysAskWhereToSaveDownloadOption,
+		Browser_BackgroundTabsRestoringLimitOption,
+		Browser_DelayRestoringOfBackgroundTabsOption,
+		Browser_EnableCookiesOption,
+		Browser_EnableImagesOption,
+		Browser_EnableJavaOption,
+		Browser_EnableJavaScriptOption,
+		Browser_EnableLocalStorageOption,
+		Browser_EnableOfflineStorageDatabaseOption,
+		Browser_EnableOfflineWebApplicationCacheOption,
+		Browser_EnablePluginsOption,
+		Browser_EnableTrayIconOption,
+		Browser_GesturesProfilesOrderOption,
+		Browser_HomePageOption,
+		Browser_JavaScriptCanAccessClipboardOption,
+		Browser_JavaScriptCanCloseWindowsOption,
+		Browser_JavaScriptCanDisableContextMenuOption,
+		Browser_JavaScriptCanOpenWindowsOption,
+		Browser_JavaScriptCanShowStatusMessagesOption,
+		Browser_KeyboardShortcutsProfilesOrderOption,
+		Browser_LocaleOption,
+		Browser_OfflineStorageLimitOption,
+		Browser_OfflineWebApplicationCacheLimitOption,
+		Browser_OpenLinksInNewTabOption,
+		Browser_PrivateModeOption,
+		Browser_ReuseCurrentTabOption,
+		Browser_ShowDetailedProgressBarOption,
+		Browser_ShowSelectionContextMenuOnDoubleClickOption,
+		Browser_SqliteJournalModeOption,
+		Browser_StartupBehaviorOption,
+		Browser_TabHibernationIdleTimeOption,
+		Browser_TabHibernationMaximumTabsOption,
+		Browser_TabHibernationMemoryLimitOption,
+		Browser_ToolTipsModeOption,
+		Browser_TransferStartingActionOption,
+		Cache_DiskCacheLimitOption,
+		Cache_EnableCompressionOption,
+		Cache_MemoryCacheLimitOption,
+		Cache_PagesInMemoryLimitOption,
+		Choices_WarnFormResendOption,
+		Choices_WarnOpenBookmarkFolderOption,
+		Choices_WarnQuitOption,
+		Choices_WarnQuitTransfersOption,
+		Content_BackgroundColorOption,
+		Content_CursiveFontOption,
+		Content_DefaultFixedFontSizeOption,
+		Content_DefaultFontSizeOption,
+		Content_DefaultZoomOption,
+		Content_FantasyFontOption,
+		Content_FixedFontOption,
+		Content_LinkColorOption,
+		Content_MinimumFontSizeOption,
+		Content_PageReloadTimeOption,
+		Content_SansSerifFontOption,
+		Content_SerifFontOption,
+		Content_StandardFontOption,
+		Content_TextColorOption,
+		Content_UserStyleSheetOption,
+		Content_VisitedLinkColorOption,
+		Content_ZoomTextOnlyOption,
+		History_BrowsingLimitAmountGlobalOption,
+		History_BrowsingLimitAmountWindowOption,
+		History_BrowsingLimitPeriodOption,
+		History_ClearOnCloseOption,
+		History_ClosedWindowsLimitAmountOption,
+		History_ClosedWindowsMemoryLimitAmountOption,
+		History_DownloadsLimitPeriodOption,
+		History_ExpandBranchesOption,
+		History_ManualClearOptionsOption,
+		History_ManualClearPeriodOption,
+		History_RememberBrowsingOption,
+		History_RememberDownloadsOption,
+		History_StoreFaviconsOption,
+		Interface_LockToolBarsOption,
+		Interface_MaximizeNewWindowsOption,
+		Interface_ShowMenuBarOption,
+		Network_AcceptLanguageOption,
+		Network_DoNotTrackPolicyOption,
+		Network_EnableReferrerOption,
+		Network_EnableRequestLogOption,
+		Network_EnableSpeculativeConnectionsOption,
+		Network_ProxyModeOption,
+		Network_ThirdPartyCookiesPolicyOption,
+		Network_UserAgentOption,
+		Network_WorkOfflineOption,
+		Paths_DownloadsOption,
+		Paths_SaveFileOption,
+		Proxy_AutomaticConfigurationPathOption,
+		Proxy_CommonPortOption,
+		Proxy_CommonServersOption,
+		Proxy_FtpPortOption,
+		Proxy_FtpServersOption,
+		Proxy_HttpPortOption,
+		Proxy_HttpServersOption,
+		Proxy_HttpsPortOption,
+		Proxy_HttpsServersOption,
+		Proxy_SocksPortOption,
+		Proxy_SocksServersOption,
+		Proxy_UseCommonOption,
+		Proxy_UseFtpOption,
+		Proxy_UseHttpOption,
+		Proxy_UseHttpsOption,
+		Proxy_UseSocksOption,
+		Proxy_UseSystemAuthenticationOption,
+		Search_DefaultSearchEngineOption,
+		Search_EnableFindInPageAsYouTypeOption,
+		Search_ReuseLastQuickFindQueryOption,
+		Search_SearchEnginesOrderOption,
+		Search_SearchEnginesSuggestionsOption,
+		Security_CiphersOption,
+		Sidebar_CurrentPanelOption,
+		Sidebar_PanelsOption,
+		TabBar_CloseOnDoubleClickOption,
+		TabBar_CloseOnMiddleClickOption,
+		TabBar_EnablePreviewsOption,
+		TabBar_LastTabClosingActionOption,
+		TabBar_OpenNextToActiveOption,
+		TabBar_RequireModifierToSwitchTabOnScrollOption,
+		TabBar_ShowCloseButtonOption,
+		TabBar_ShowUrlIconOption
+	};
+
+	enum OptionType
+	{
+		UnknownType = 0,
+		BooleanType,
+		ColorType,
+		EnumerationType,
+		FontType,
+		IntegerType,
+		PathType,
+		StringType
+	};
+
+	~SettingsManager();
+
 	static void createInstance(const QString &path, QObject *parent = NULL);
+	static void addListener(QObject *object, const QList<int> &identifiers);
+	static void addGroupListener(QObject *object, const QString &group);
+	static void removeListener(QObject *object);
+	static void loadDefaults(const QString &path);
 	static void registerOption(const QString &key);
 	static void removeOverride(const QUrl &url, const QString &key = QString());
 	static void setDefaultValue(const QString &key, const QVariant &value);
 	static void setValue(const QString &key, const QVariant &value, const QUrl &url = QUrl());
 	static SettingsManager* getInstance();
+	static QString getOptionName(int identifier);
 	static QVariant getDefaultValue(const QString &key);
+	static QVariant getDefaultValue(int identifier);
 	static QVariant getValue(const QString &key, const QUrl &url = QUrl());
+	static QVariant getValue(int identifier);
+	static OptionType getOptionType(int identifier);
+	static QHash<QString, QVariant> getOverrides(const QUrl &url);
+	static int getOptionIdentifier(const QString &key);
 	static bool hasOverride(const QUrl &url, const QString &key = QString());
 
 protected:
+	struct OverridesSnapshot
+	{
+		QHash<QString, QVariant> values;
+		quint64 lastUsed;
+
+		OverridesSnapshot() : lastUsed(0) {}
+	};
+
 	explicit SettingsManager(QObject *parent = NULL);
 
+	void timerEvent(QTimerEvent *event);
+	void scheduleSave();
+	static void loadGlobal();
+	static void loadOverrides();
+	static void saveGlobal();
+	static void saveOverrides();
+	static void notifyListeners(int identifier, const QVariant &value);
+	static QString getHost(const QUrl &url);
+	static QVariant convertValue(int identifier, const QVariant &value);
+	static int createOptionIdentifier(const QString &key);
+
+protected slots:
+	void handleFileChanged(const QString &path);
+	void handleListenerDestroyed(QObject *object);
+
 private:
+	QFileSystemWatcher *m_watcher;
+	int m_saveTimer;
+
 	static SettingsManager *m_instance;
 	static QString m_globalPath;
 	static QString m_overridePath;
-	static QHash<QString, QVariant> m_defaults;
+	static QHash<QString, int> m_identifiers;
+	static QStringList m_options;
+	static QVector<QVariant> m_defaults;
+	static QVector<OptionType> m_types;
+	static QHash<int, QVariant> m_values;
+	static QHash<int, QList<QObject*> > m_listeners;
+	static QHash<QObject*, QList<int> > m_listenersOptions;
+	static QHash<QString, QList<QObject*> > m_groupListeners;
+	static QHash<QObject*, QStringList> m_listenersGroups;
+	static QHash<QString, QHash<QString, QVariant> > m_overrides;
+	static QHash<QString, OverridesSnapshot> m_snapshots;
+	static quint64 m_snapshotsCounter;
+	static QDateTime m_globalModified;
+	static QDateTime m_overrideModified;
+	static bool m_isGlobalModified;
+	static bool m_isOverrideModified;
 
 signals:
 	void valueChanged(QString key, QVariant value);
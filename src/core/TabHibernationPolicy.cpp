@@ -0,0 +1,150 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2013 - 2014 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "TabHibernationPolicy.h"
+#include "Application.h"
+#include "SettingsManager.h"
+#include "WindowsManager.h"
+#include "../ui/MainWindow.h"
+#include "../ui/Window.h"
+
+#include <QtCore/QMultiMap>
+#include <QtCore/QTimerEvent>
+
+namespace Otter
+{
+
+TabHibernationPolicy::TabHibernationPolicy(QObject *parent) : QObject(parent),
+	m_memoryLimit(SettingsManager::getValue(SettingsManager::Browser_TabHibernationMemoryLimitOption).toLongLong() * 1048576),
+	m_idleTime(SettingsManager::getValue(SettingsManager::Browser_TabHibernationIdleTimeOption).toInt()),
+	m_maximumTabs(SettingsManager::getValue(SettingsManager::Browser_TabHibernationMaximumTabsOption).toInt()),
+	m_hibernationTimer(0)
+{
+	updateTimer();
+
+	SettingsManager::addListener(this, QList<int>() << SettingsManager::Browser_TabHibernationIdleTimeOption << SettingsManager::Browser_TabHibernationMaximumTabsOption << SettingsManager::Browser_TabHibernationMemoryLimitOption);
+}
+
+void TabHibernationPolicy::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == m_hibernationTimer)
+	{
+		hibernateWindows();
+	}
+}
+
+void TabHibernationPolicy::optionChanged(int identifier, const QVariant &value)
+{
+	if (identifier == SettingsManager::Browser_TabHibernationIdleTimeOption)
+	{
+		m_idleTime = value.toInt();
+	}
+	else if (identifier == SettingsManager::Browser_TabHibernationMaximumTabsOption)
+	{
+		m_maximumTabs = value.toInt();
+	}
+	else if (identifier == SettingsManager::Browser_TabHibernationMemoryLimitOption)
+	{
+		m_memoryLimit = (value.toLongLong() * 1048576);
+	}
+
+	updateTimer();
+}
+
+void TabHibernationPolicy::updateTimer()
+{
+	const bool isEnabled = (m_idleTime > 0 || m_maximumTabs > 0 || m_memoryLimit > 0);
+
+	if (isEnabled && m_hibernationTimer == 0)
+	{
+		m_hibernationTimer = startTimer(60000);
+	}
+	else if (!isEnabled && m_hibernationTimer != 0)
+	{
+		killTimer(m_hibernationTimer);
+
+		m_hibernationTimer = 0;
+	}
+}
+
+void TabHibernationPolicy::hibernateWindows()
+{
+	if (m_idleTime <= 0 && m_maximumTabs <= 0 && m_memoryLimit <= 0)
+	{
+		return;
+	}
+
+	const QList<MainWindow*> mainWindows = Application::getInstance()->getWindows();
+	QMultiMap<QDateTime, Window*> candidates;
+	qint64 memoryUsage = 0;
+	int liveTabs = 0;
+
+	for (int i = 0; i < mainWindows.count(); ++i)
+	{
+		WindowsManager *manager = mainWindows.at(i)->getWindowsManager();
+		Window *activeWindow = manager->getWindow();
+
+		for (int j = 0; j < manager->getWindowCount(); ++j)
+		{
+			Window *window = manager->getWindow(j);
+
+			if (!window || window->getLoadingState() == DelayedState)
+			{
+				continue;
+			}
+
+			memoryUsage += window->getEstimatedMemoryUsage();
+
+			if (window != activeWindow)
+			{
+				++liveTabs;
+
+				if (!window->isPinned() && !window->isPrivate())
+				{
+					candidates.insert(window->getLastActivity(), window);
+				}
+			}
+		}
+	}
+
+	const QDateTime idleLimit = QDateTime::currentDateTime().addSecs(-60 * m_idleTime);
+	QMultiMap<QDateTime, Window*>::iterator iterator;
+
+	for (iterator = candidates.begin(); iterator != candidates.end(); ++iterator)
+	{
+		const bool isIdle = (m_idleTime > 0 && iterator.key() < idleLimit);
+		const bool isOverLimit = ((m_maximumTabs > 0 && liveTabs > m_maximumTabs) || (m_memoryLimit > 0 && memoryUsage > m_memoryLimit));
+
+		if (!isIdle && !isOverLimit)
+		{
+			break;
+		}
+
+		const qint64 windowUsage = iterator.value()->getEstimatedMemoryUsage();
+
+		if (iterator.value()->hibernate())
+		{
+			memoryUsage -= windowUsage;
+
+			--liveTabs;
+		}
+	}
+}
+
+}
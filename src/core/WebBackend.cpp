@@ -18,12 +18,45 @@
 **************************************************************************/
 
 #include "WebBackend.h"
+#include "Utils.h"
 
 namespace Otter
 {
 
-WebBackend::WebBackend(QObject *parent) : QObject(parent)
+WebBackend::WebBackend(QObject *parent) : QObject(parent),
+	m_icons(500)
 {
 }
 
+void WebBackend::markIconChanged(const QUrl &url)
+{
+	m_icons.remove(getIconCacheKey(url));
+
+	emit iconChanged(url);
+}
+
+QString WebBackend::getIconCacheKey(const QUrl &url)
+{
+	if (url.host().isEmpty())
+	{
+		return url.toString(QUrl::RemoveQuery | QUrl::RemoveFragment);
+	}
+
+	return url.host();
+}
+
+QIcon WebBackend::getIconForUrl(const QUrl &url)
+{
+	const QString key = getIconCacheKey(url);
+
+	if (!m_icons.contains(key))
+	{
+		m_icons.insert(key, new QIcon(loadIconForUrl(url)));
+	}
+
+	const QIcon icon = *m_icons.object(key);
+
+	return (icon.isNull() ? Utils::getIcon(QLatin1String("text-html")) : icon);
+}
+
 }
@@ -20,6 +20,7 @@
 #ifndef OTTER_WEBBACKEND_H
 #define OTTER_WEBBACKEND_H
 
+#include <QtCore/QCache>
 #include <QtCore/QObject>
 #include <QtCore/QUrl>
 #include <QtGui/QIcon>
@@ -43,7 +44,20 @@ public:
 	virtual QString getVersion() const = 0;
 	virtual QString getEngineVersion() const = 0;
 	virtual QString getUserAgent(const QString &pattern = QString()) const = 0;
-	virtual QIcon getIconForUrl(const QUrl &url) = 0;
+	QIcon getIconForUrl(const QUrl &url);
+
+public slots:
+	void markIconChanged(const QUrl &url);
+
+protected:
+	virtual QIcon loadIconForUrl(const QUrl &url) = 0;
+	static QString getIconCacheKey(const QUrl &url);
+
+private:
+	QCache<QString, QIcon> m_icons;
+
+signals:
+	void iconChanged(const QUrl &url);
 };
 
 }
@@ -285,21 +285,46 @@ void WindowsManager::restore(const SessionMainWindow &session)
 	connect(m_mainWindow->getTabBar(), SIGNAL(requestedPin(int,bool)), this, SLOT(pinWindow(int,bool)));
 	connect(m_mainWindow->getTabBar(), SIGNAL(requestedClose(int)), this, SLOT(closeWindow(int)));
 	connect(m_mainWindow->getTabBar(), SIGNAL(requestedCloseOther(int)), this, SLOT(closeOther(int)));
+	connect(m_mainWindow->getTabBar(), SIGNAL(tabMoved(int,int)), this, SLOT(notifySessionModified()));
+	connect(this, SIGNAL(windowAdded(int)), this, SLOT(notifySessionModified()));
+	connect(this, SIGNAL(windowRemoved(int)), this, SLOT(notifySessionModified()));
+	connect(this, SIGNAL(currentWindowChanged(int)), this, SLOT(notifySessionModified()));
 
 	setActiveWindow(session.index);
+
+	if (!SettingsManager::getValue(QLatin1String("Browser/DelayRestoringOfBackgroundTabs")).toBool())
+	{
+		const int index = m_mainWindow->getTabBar()->currentIndex();
+		QList<Window*> windows;
+
+		for (int i = 1; i < m_mainWindow->getTabBar()->count(); ++i)
+		{
+			if (index + i < m_mainWindow->getTabBar()->count())
+			{
+				windows.append(getWindow(index + i));
+			}
+
+			if (index - i >= 0)
+			{
+				windows.append(getWindow(index - i));
+			}
+		}
+
+		SessionsManager::scheduleRestore(windows);
+	}
 }
 
 void WindowsManager::restore(int index)
 {
-	if (index < 0 || index >= m_closedWindows.count())
+	if (index < 0 || index >= m_closedWindows.getCount())
 	{
 		return;
 	}
 
 	Window *window = new Window(m_isPrivate, NULL, m_mainWindow->getMdi());
-	window->setSession(m_closedWindows.at(index));
+	window->setSession(m_closedWindows.getWindow(index));
 
-	m_closedWindows.removeAt(index);
+	m_closedWindows.removeWindow(index);
 
 	if (m_closedWindows.isEmpty() && SessionsManager::getClosedWindows().isEmpty())
 	{
@@ -307,6 +332,11 @@ void WindowsManager::restore(int index)
 	}
 
 	addWindow(window);
+
+	if (!SettingsManager::getValue(QLatin1String("Browser/DelayRestoringOfBackgroundTabs")).toBool())
+	{
+		SessionsManager::scheduleRestore(QList<Window*>() << window);
+	}
 }
 
 void WindowsManager::triggerAction(int identifier, bool checked)
@@ -523,18 +553,16 @@ void WindowsManager::closeWindow(Window *window)
 
 	if (window && !window->isPrivate())
 	{
-		const WindowHistoryInformation history = window->getContentsWidget()->getHistory();
+		const SessionWindow information = window->getSession();
 
-		if (!window->isUrlEmpty() || history.entries.count() > 1)
+		if (!window->isUrlEmpty() || information.history.count() > 1)
 		{
-			const SessionWindow information = window->getSession();
-
 			if (window->getType() != QLatin1String("web"))
 			{
 				removeStoredUrl(information.getUrl());
 			}
 
-			m_closedWindows.prepend(information);
+			m_closedWindows.addWindow(information);
 
 			emit closedWindowsAvailableChanged(true);
 		}
@@ -582,15 +610,7 @@ void WindowsManager::closeWindow(Window *window)
 
 void WindowsManager::removeStoredUrl(const QString &url)
 {
-	for (int i = (m_closedWindows.count() - 1); i >= 0; --i)
-	{
-		if (url == m_closedWindows.at(i).getUrl())
-		{
-			m_closedWindows.removeAt(i);
-
-			break;
-		}
-	}
+	m_closedWindows.removeWindow(m_closedWindows.findUrl(url));
 
 	if (m_closedWindows.isEmpty())
 	{
@@ -598,6 +618,14 @@ void WindowsManager::removeStoredUrl(const QString &url)
 	}
 }
 
+void WindowsManager::notifySessionModified()
+{
+	if (!m_isPrivate)
+	{
+		SessionsManager::markSessionModified();
+	}
+}
+
 void WindowsManager::setOption(const QString &key, const QVariant &value)
 {
 	Window *window = m_mainWindow->getMdi()->getActiveWindow();
@@ -752,9 +780,9 @@ SessionMainWindow WindowsManager::getSession() const
 	return session;
 }
 
-QList<SessionWindow> WindowsManager::getClosedWindows() const
+QList<ClosedWindow> WindowsManager::getClosedWindows() const
 {
-	return m_closedWindows;
+	return m_closedWindows.getInformation();
 }
 
 OpenHints WindowsManager::calculateOpenHints(Qt::KeyboardModifiers modifiers, Qt::MouseButton button, OpenHints hints)
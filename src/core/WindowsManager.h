@@ -21,6 +21,7 @@
 #define OTTER_WINDOWSMANAGER_H
 
 #include "ActionsManager.h"
+#include "ClosedWindowsStore.h"
 #include "SessionsManager.h"
 
 #include <QtCore/QUrl>
@@ -66,7 +67,7 @@ public:
 	QString getTitle() const;
 	QUrl getUrl() const;
 	SessionMainWindow getSession() const;
-	QList<SessionWindow> getClosedWindows() const;
+	QList<ClosedWindow> getClosedWindows() const;
 	static OpenHints calculateOpenHints(Qt::KeyboardModifiers modifiers = Qt::NoModifier, Qt::MouseButton button = Qt::LeftButton, OpenHints hints = DefaultOpen);
 	int getWindowCount() const;
 	int getZoom() const;
@@ -103,12 +104,13 @@ protected slots:
 	void closeWindow(int index);
 	void closeWindow(Window *window);
 	void removeStoredUrl(const QString &url);
+	void notifySessionModified();
 	void setTitle(const QString &title);
 	void setStatusMessage(const QString &message);
 
 private:
 	MainWindow *m_mainWindow;
-	QList<SessionWindow> m_closedWindows;
+	ClosedWindowsStore m_closedWindows;
 	QList<QUrl> m_bookmarksToOpen;
 	bool m_isPrivate;
 	bool m_isRestored;
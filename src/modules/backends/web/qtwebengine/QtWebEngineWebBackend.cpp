@@ -21,7 +21,6 @@
 #include "QtWebEngineWebWidget.h"
 #include "../../../../core/NetworkManagerFactory.h"
 #include "../../../../core/SettingsManager.h"
-#include "../../../../core/Utils.h"
 
 #include <QtCore/QCoreApplication>
 #include <QtWebEngineWidgets/QWebEngineSettings>
@@ -34,12 +33,10 @@ QtWebEngineWebBackend::QtWebEngineWebBackend(QObject *parent) : WebBackend(paren
 {
 }
 
-void QtWebEngineWebBackend::optionChanged(const QString &option)
+void QtWebEngineWebBackend::optionChanged(int identifier, const QVariant &value)
 {
-	if (!(option.startsWith(QLatin1String("Browser/")) || option.startsWith(QLatin1String("Content/"))))
-	{
-		return;
-	}
+	Q_UNUSED(identifier)
+	Q_UNUSED(value)
 
 	QWebEngineSettings *globalSettings = QWebEngineSettings::globalSettings();
 	globalSettings->setAttribute(QWebEngineSettings::AutoLoadImages, SettingsManager::getValue(QLatin1String("Browser/EnableImages")).toBool());
@@ -64,9 +61,10 @@ WebWidget* QtWebEngineWebBackend::createWidget(bool isPrivate, ContentsWidget *p
 	{
 		m_isInitialized = true;
 
-		optionChanged(QLatin1String("Browser/"));
+		optionChanged(-1, QVariant());
 
-		connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString)));
+		SettingsManager::addGroupListener(this, QLatin1String("Browser/"));
+		SettingsManager::addGroupListener(this, QLatin1String("Content/"));
 	}
 
 	return new QtWebEngineWebWidget(isPrivate, this, parent);
@@ -97,11 +95,11 @@ QString QtWebEngineWebBackend::getUserAgent(const QString &pattern) const
 	return pattern;
 }
 
-QIcon QtWebEngineWebBackend::getIconForUrl(const QUrl &url)
+QIcon QtWebEngineWebBackend::loadIconForUrl(const QUrl &url)
 {
 	Q_UNUSED(url)
 
-	return Utils::getIcon(QLatin1String("text-html"));
+	return QIcon();
 }
 
 }
@@ -38,10 +38,12 @@ public:
 	QString getVersion() const;
 	QString getEngineVersion() const;
 	QString getUserAgent(const QString &pattern = QString()) const;
-	QIcon getIconForUrl(const QUrl &url);
+
+protected:
+	QIcon loadIconForUrl(const QUrl &url);
 
 protected slots:
-	void optionChanged(const QString &option);
+	void optionChanged(int identifier, const QVariant &value);
 
 private:
 	bool m_isInitialized;
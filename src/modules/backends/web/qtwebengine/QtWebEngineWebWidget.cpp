@@ -25,6 +25,7 @@
 #include "../../../../core/HistoryManager.h"
 #include "../../../../core/InputInterpreter.h"
 #include "../../../../core/SearchesManager.h"
+#include "../../../../core/SettingsManager.h"
 #include "../../../../core/TransfersManager.h"
 #include "../../../../core/Utils.h"
 #include "../../../../ui/AuthenticationDialog.h"
@@ -967,12 +968,12 @@ void QtWebEngineWebWidget::notifyUrlChanged(const QUrl &url)
 	updateNavigationActions();
 
 	emit urlChanged(url);
-
-	SessionsManager::markSessionModified();
 }
 
 void QtWebEngineWebWidget::notifyIconChanged()
 {
+	getBackend()->markIconChanged(getUrl());
+
 	emit iconChanged(getIcon());
 }
 
@@ -1284,13 +1285,14 @@ void QtWebEngineWebWidget::updateBookmarkActions()
 
 void QtWebEngineWebWidget::updateOptions(const QUrl &url)
 {
+	const QVariantHash overrides = SettingsManager::getOverrides(url.isEmpty() ? getUrl() : url);
 	QWebEngineSettings *settings = m_webView->page()->settings();
-	settings->setAttribute(QWebEngineSettings::AutoLoadImages, getOption(QLatin1String("Browser/EnableImages"), url).toBool());
-	settings->setAttribute(QWebEngineSettings::JavascriptEnabled, getOption(QLatin1String("Browser/EnableJavaScript"), url).toBool());
-	settings->setAttribute(QWebEngineSettings::JavascriptCanAccessClipboard, getOption(QLatin1String("Browser/JavaScriptCanAccessClipboard"), url).toBool());
-	settings->setAttribute(QWebEngineSettings::JavascriptCanOpenWindows, getOption(QLatin1String("Browser/JavaScriptCanOpenWindows"), url).toBool());
-	settings->setAttribute(QWebEngineSettings::LocalStorageEnabled, getOption(QLatin1String("Browser/EnableLocalStorage"), url).toBool());
-	settings->setDefaultTextEncoding(getOption(QLatin1String("Content/DefaultCharacterEncoding"), url).toString());
+	settings->setAttribute(QWebEngineSettings::AutoLoadImages, getOption(QLatin1String("Browser/EnableImages"), overrides).toBool());
+	settings->setAttribute(QWebEngineSettings::JavascriptEnabled, getOption(QLatin1String("Browser/EnableJavaScript"), overrides).toBool());
+	settings->setAttribute(QWebEngineSettings::JavascriptCanAccessClipboard, getOption(QLatin1String("Browser/JavaScriptCanAccessClipboard"), overrides).toBool());
+	settings->setAttribute(QWebEngineSettings::JavascriptCanOpenWindows, getOption(QLatin1String("Browser/JavaScriptCanOpenWindows"), overrides).toBool());
+	settings->setAttribute(QWebEngineSettings::LocalStorageEnabled, getOption(QLatin1String("Browser/EnableLocalStorage"), overrides).toBool());
+	settings->setDefaultTextEncoding(getOption(QLatin1String("Content/DefaultCharacterEncoding"), overrides).toString());
 }
 
 void QtWebEngineWebWidget::showContextMenu(const QPoint &position)
@@ -1337,8 +1339,6 @@ void QtWebEngineWebWidget::setZoom(int zoom)
 	{
 		m_webView->setZoomFactor(qBound(0.1, ((qreal) zoom / 100), (qreal) 100));
 
-		SessionsManager::markSessionModified();
-
 		emit zoomChanged(zoom);
 		emit progressBarGeometryChanged();
 	}
@@ -1430,6 +1430,7 @@ Action* QtWebEngineWebWidget::getAction(int identifier)
 		case Action::ViewSourceAction:
 		case Action::InspectPageAction:
 		case Action::InspectElementAction:
+		case Action::ExportNetworkLogAction:
 		case Action::LoadPluginsAction:
 			action->setEnabled(false);
 
@@ -32,6 +32,9 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QtNetwork/QNetworkProxy>
 #include <QtNetwork/QNetworkReply>
 
@@ -49,8 +52,11 @@ QtWebKitNetworkManager::QtWebKitNetworkManager(bool isPrivate, QtWebKitWebWidget
 	m_startedRequests(0),
 	m_updateTimer(0),
 	m_doNotTrackPolicy(NetworkManagerFactory::SkipTrackPolicy),
-	m_canSendReferrer(true)
+	m_canSendReferrer(true),
+	m_isLoggingEnabled(false)
 {
+	m_timer.start();
+
 	connect(this, SIGNAL(finished(QNetworkReply*)), SLOT(requestFinished(QNetworkReply*)));
 }
 
@@ -201,6 +207,9 @@ void QtWebKitNetworkManager::resetStatistics()
 
 	m_updateTimer = 0;
 	m_replies.clear();
+	m_timingReplies.clear();
+	m_timings.clear();
+	m_timer.restart();
 	m_baseReply = NULL;
 	m_speed = 0;
 	m_bytesReceivedDifference = 0;
@@ -238,6 +247,11 @@ void QtWebKitNetworkManager::downloadProgress(qint64 bytesReceived, qint64 bytes
 		return;
 	}
 
+	if (bytesReceived > 0 && m_timingReplies.contains(reply) && m_timings[m_timingReplies[reply]].firstByte < 0)
+	{
+		m_timings[m_timingReplies[reply]].firstByte = m_timer.elapsed();
+	}
+
 	emit messageChanged(tr("Receiving data from %1…").arg(reply->url().host()));
 
 	const qint64 difference = (bytesReceived - m_replies[reply].first);
@@ -260,8 +274,70 @@ void QtWebKitNetworkManager::downloadProgress(qint64 bytesReceived, qint64 bytes
 	m_bytesReceivedDifference += difference;
 }
 
+void QtWebKitNetworkManager::handleReplyEncrypted()
+{
+	QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+
+	if (reply && m_timingReplies.contains(reply) && m_timings[m_timingReplies[reply]].encrypted < 0)
+	{
+		m_timings[m_timingReplies[reply]].encrypted = m_timer.elapsed();
+	}
+}
+
+void QtWebKitNetworkManager::handleReplyMetaDataChanged()
+{
+	QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+
+	if (!reply || !m_timingReplies.contains(reply))
+	{
+		return;
+	}
+
+	RequestTiming &timing = m_timings[m_timingReplies[reply]];
+
+	if (timing.headersReceived < 0)
+	{
+		timing.headersReceived = m_timer.elapsed();
+	}
+
+	timing.status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	timing.statusText = reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString();
+	timing.mimeType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
+	timing.responseHeaders = reply->rawHeaderPairs();
+
+#if QT_VERSION >= 0x050900
+	if (reply->attribute(QNetworkRequest::HTTP2WasUsedAttribute).toBool())
+	{
+		timing.httpVersion = QLatin1String("HTTP/2.0");
+	}
+	else if (reply->attribute(QNetworkRequest::SpdyWasUsedAttribute).toBool())
+	{
+		timing.httpVersion = QLatin1String("SPDY/3");
+	}
+#elif QT_VERSION >= 0x050300
+	if (reply->attribute(QNetworkRequest::SpdyWasUsedAttribute).toBool())
+	{
+		timing.httpVersion = QLatin1String("SPDY/3");
+	}
+#endif
+}
+
 void QtWebKitNetworkManager::requestFinished(QNetworkReply *reply)
 {
+	if (reply && m_timingReplies.contains(reply))
+	{
+		RequestTiming &timing = m_timings[m_timingReplies.take(reply)];
+		timing.finished = m_timer.elapsed();
+		timing.size = m_replies.value(reply).first;
+		timing.isCached = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+
+		if (timing.status == 0)
+		{
+			timing.status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+			timing.statusText = reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString();
+		}
+	}
+
 	m_replies.remove(reply);
 
 	if (m_replies.isEmpty())
@@ -280,6 +356,8 @@ void QtWebKitNetworkManager::requestFinished(QNetworkReply *reply)
 		emit messageChanged(tr("Completed request to %1").arg(reply->url().host()));
 
 		disconnect(reply, SIGNAL(downloadProgress(qint64,qint64)), this, SLOT(downloadProgress(qint64,qint64)));
+		disconnect(reply, SIGNAL(encrypted()), this, SLOT(handleReplyEncrypted()));
+		disconnect(reply, SIGNAL(metaDataChanged()), this, SLOT(handleReplyMetaDataChanged()));
 	}
 }
 
@@ -291,6 +369,71 @@ void QtWebKitNetworkManager::updateStatus()
 	emit statusChanged(m_finishedRequests, m_startedRequests, m_bytesReceived, m_bytesTotal, m_speed);
 }
 
+void QtWebKitNetworkManager::addRequestTiming(const QNetworkRequest &request, Operation operation, QNetworkReply *reply, qint64 started)
+{
+	if (!m_isLoggingEnabled || m_timings.count() >= 2000)
+	{
+		return;
+	}
+
+	RequestTiming timing;
+	timing.url = request.url();
+	timing.httpVersion = QLatin1String("HTTP/1.1");
+	timing.started = started;
+	timing.queued = m_timer.elapsed();
+	timing.startDateTime = QDateTime::currentDateTime().addMSecs(started - timing.queued);
+
+	switch (operation)
+	{
+		case HeadOperation:
+			timing.method = QLatin1String("HEAD");
+
+			break;
+		case PutOperation:
+			timing.method = QLatin1String("PUT");
+
+			break;
+		case PostOperation:
+			timing.method = QLatin1String("POST");
+
+			break;
+		case DeleteOperation:
+			timing.method = QLatin1String("DELETE");
+
+			break;
+		case CustomOperation:
+			timing.method = QString::fromLatin1(request.attribute(QNetworkRequest::CustomVerbAttribute).toByteArray());
+
+			break;
+		default:
+			timing.method = QLatin1String("GET");
+
+			break;
+	}
+
+	const QList<QByteArray> headers = request.rawHeaderList();
+
+	for (int i = 0; i < headers.count(); ++i)
+	{
+		timing.requestHeaders.append(qMakePair(headers.at(i), request.rawHeader(headers.at(i))));
+	}
+
+	if (reply)
+	{
+		m_timingReplies[reply] = m_timings.count();
+
+		connect(reply, SIGNAL(encrypted()), this, SLOT(handleReplyEncrypted()));
+		connect(reply, SIGNAL(metaDataChanged()), this, SLOT(handleReplyMetaDataChanged()));
+	}
+	else
+	{
+		timing.finished = timing.queued;
+		timing.isBlocked = true;
+	}
+
+	m_timings.append(timing);
+}
+
 void QtWebKitNetworkManager::updateOptions(const QUrl &url)
 {
 	QString acceptLanguage = SettingsManager::getValue(QLatin1String("Network/AcceptLanguage"), url).toString();
@@ -314,6 +457,14 @@ void QtWebKitNetworkManager::updateOptions(const QUrl &url)
 	}
 
 	m_canSendReferrer = SettingsManager::getValue(QLatin1String("Network/EnableReferrer"), url).toBool();
+
+	m_isLoggingEnabled = SettingsManager::getValue(QLatin1String("Network/EnableRequestLog"), url).toBool();
+
+	if (!m_isLoggingEnabled)
+	{
+		m_timingReplies.clear();
+		m_timings.clear();
+	}
 }
 
 void QtWebKitNetworkManager::setFormRequest(const QUrl &url)
@@ -328,8 +479,13 @@ void QtWebKitNetworkManager::setWidget(QtWebKitWebWidget *widget)
 
 QtWebKitNetworkManager* QtWebKitNetworkManager::clone()
 {
-	QtWebKitNetworkManager *manager = new QtWebKitNetworkManager((cache() == NULL), NULL);
-	manager->setCookieJar(getCookieJar()->clone(manager));
+	const bool isPrivate = (cache() == NULL);
+	QtWebKitNetworkManager *manager = new QtWebKitNetworkManager(isPrivate, NULL);
+
+	if (isPrivate)
+	{
+		manager->setSharedCookieJar(getCookieJar());
+	}
 
 	return manager;
 }
@@ -347,10 +503,14 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 
 	++m_startedRequests;
 
+	const qint64 started = m_timer.elapsed();
+
 	if (ContentBlockingManager::isContentBlockingEnabled() && ContentBlockingManager::isUrlBlocked(request, m_widget->getUrl()))
 	{
 		Console::addMessage(QCoreApplication::translate("main", "Blocked content: %0").arg(request.url().url()), Otter::NetworkMessageCategory, LogMessageLevel);
 
+		addRequestTiming(request, operation, NULL, started);
+
 		QUrl url = QUrl();
 		url.setScheme(QLatin1String("http"));
 
@@ -387,7 +547,9 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 
 	emit messageChanged(tr("Sending request to %1…").arg(request.url().host()));
 
-	QNetworkReply *reply = QNetworkAccessManager::createRequest(operation, mutableRequest, outgoingData);
+	QNetworkReply *reply = sendRequest(operation, mutableRequest, outgoingData);
+
+	addRequestTiming(mutableRequest, operation, reply, started);
 
 	if (!m_baseReply)
 	{
@@ -435,4 +597,111 @@ QVariantHash QtWebKitNetworkManager::getStatistics() const
 	return statistics;
 }
 
+QByteArray QtWebKitNetworkManager::getNetworkLog() const
+{
+	QJsonArray entries;
+
+	for (int i = 0; i < m_timings.count(); ++i)
+	{
+		const RequestTiming &timing = m_timings.at(i);
+		const qint64 connected = ((timing.encrypted >= 0) ? timing.encrypted : timing.queued);
+		const qint64 responseStarted = ((timing.firstByte >= 0) ? timing.firstByte : ((timing.headersReceived >= 0) ? timing.headersReceived : connected));
+		QJsonArray requestHeaders;
+		QJsonArray responseHeaders;
+
+		for (int j = 0; j < timing.requestHeaders.count(); ++j)
+		{
+			QJsonObject header;
+			header.insert(QLatin1String("name"), QString::fromLatin1(timing.requestHeaders.at(j).first));
+			header.insert(QLatin1String("value"), QString::fromLatin1(timing.requestHeaders.at(j).second));
+
+			requestHeaders.append(header);
+		}
+
+		for (int j = 0; j < timing.responseHeaders.count(); ++j)
+		{
+			QJsonObject header;
+			header.insert(QLatin1String("name"), QString::fromLatin1(timing.responseHeaders.at(j).first));
+			header.insert(QLatin1String("value"), QString::fromLatin1(timing.responseHeaders.at(j).second));
+
+			responseHeaders.append(header);
+		}
+
+		QJsonObject request;
+		request.insert(QLatin1String("method"), timing.method);
+		request.insert(QLatin1String("url"), timing.url.toString());
+		request.insert(QLatin1String("httpVersion"), timing.httpVersion);
+		request.insert(QLatin1String("headers"), requestHeaders);
+		request.insert(QLatin1String("cookies"), QJsonArray());
+		request.insert(QLatin1String("queryString"), QJsonArray());
+		request.insert(QLatin1String("headersSize"), -1);
+		request.insert(QLatin1String("bodySize"), -1);
+
+		QJsonObject content;
+		content.insert(QLatin1String("size"), timing.size);
+		content.insert(QLatin1String("mimeType"), timing.mimeType);
+
+		QJsonObject response;
+		response.insert(QLatin1String("status"), timing.status);
+		response.insert(QLatin1String("statusText"), timing.statusText);
+		response.insert(QLatin1String("httpVersion"), timing.httpVersion);
+		response.insert(QLatin1String("headers"), responseHeaders);
+		response.insert(QLatin1String("cookies"), QJsonArray());
+		response.insert(QLatin1String("content"), content);
+		response.insert(QLatin1String("redirectURL"), QString());
+		response.insert(QLatin1String("headersSize"), -1);
+		response.insert(QLatin1String("bodySize"), (timing.isCached ? 0 : timing.size));
+
+		QJsonObject timings;
+		timings.insert(QLatin1String("blocked"), (timing.queued - timing.started));
+		timings.insert(QLatin1String("dns"), -1);
+		timings.insert(QLatin1String("connect"), -1);
+		timings.insert(QLatin1String("ssl"), ((timing.encrypted >= 0) ? (timing.encrypted - timing.queued) : -1));
+		timings.insert(QLatin1String("send"), 0);
+		timings.insert(QLatin1String("wait"), (responseStarted - connected));
+		timings.insert(QLatin1String("receive"), ((timing.finished >= 0) ? qMax(qint64(0), (timing.finished - responseStarted)) : 0));
+
+		QJsonObject entry;
+		entry.insert(QLatin1String("pageref"), QLatin1String("page_1"));
+		entry.insert(QLatin1String("startedDateTime"), timing.startDateTime.toUTC().toString(QLatin1String("yyyy-MM-dd'T'HH:mm:ss.zzz'Z'")));
+		entry.insert(QLatin1String("time"), ((timing.finished >= 0) ? (timing.finished - timing.started) : -1));
+		entry.insert(QLatin1String("request"), request);
+		entry.insert(QLatin1String("response"), response);
+		entry.insert(QLatin1String("cache"), QJsonObject());
+		entry.insert(QLatin1String("timings"), timings);
+		entry.insert(QLatin1String("_fromCache"), timing.isCached);
+		entry.insert(QLatin1String("_blocked"), timing.isBlocked);
+
+		entries.append(entry);
+	}
+
+	QJsonObject pageTimings;
+	pageTimings.insert(QLatin1String("onContentLoad"), -1);
+	pageTimings.insert(QLatin1String("onLoad"), -1);
+
+	QJsonObject page;
+	page.insert(QLatin1String("id"), QLatin1String("page_1"));
+	page.insert(QLatin1String("title"), (m_widget ? m_widget->getTitle() : QString()));
+	page.insert(QLatin1String("startedDateTime"), (m_timings.isEmpty() ? QDateTime::currentDateTime() : m_timings.first().startDateTime).toUTC().toString(QLatin1String("yyyy-MM-dd'T'HH:mm:ss.zzz'Z'")));
+	page.insert(QLatin1String("pageTimings"), pageTimings);
+
+	QJsonArray pages;
+	pages.append(page);
+
+	QJsonObject creator;
+	creator.insert(QLatin1String("name"), QCoreApplication::applicationName());
+	creator.insert(QLatin1String("version"), QCoreApplication::applicationVersion());
+
+	QJsonObject log;
+	log.insert(QLatin1String("version"), QLatin1String("1.2"));
+	log.insert(QLatin1String("creator"), creator);
+	log.insert(QLatin1String("pages"), pages);
+	log.insert(QLatin1String("entries"), entries);
+
+	QJsonObject document;
+	document.insert(QLatin1String("log"), log);
+
+	return QJsonDocument(document).toJson();
+}
+
 }
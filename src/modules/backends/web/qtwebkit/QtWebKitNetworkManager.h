@@ -23,6 +23,8 @@
 #include "../../../../core/NetworkManager.h"
 #include "../../../../core/NetworkManagerFactory.h"
 
+#include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
 #include <QtNetwork/QNetworkRequest>
 
 namespace Otter
@@ -39,11 +41,37 @@ public:
 
 	QHash<QByteArray, QByteArray> getHeaders() const;
 	QVariantHash getStatistics() const;
+	QByteArray getNetworkLog() const;
 
 protected:
+	struct RequestTiming
+	{
+		QUrl url;
+		QString method;
+		QString mimeType;
+		QString statusText;
+		QString httpVersion;
+		QDateTime startDateTime;
+		QList<QPair<QByteArray, QByteArray> > requestHeaders;
+		QList<QPair<QByteArray, QByteArray> > responseHeaders;
+		qint64 started;
+		qint64 queued;
+		qint64 encrypted;
+		qint64 headersReceived;
+		qint64 firstByte;
+		qint64 finished;
+		qint64 size;
+		int status;
+		bool isCached;
+		bool isBlocked;
+
+		RequestTiming() : started(-1), queued(-1), encrypted(-1), headersReceived(-1), firstByte(-1), finished(-1), size(0), status(0), isCached(false), isBlocked(false) {}
+	};
+
 	void timerEvent(QTimerEvent *event);
 	void resetStatistics();
 	void updateStatus();
+	void addRequestTiming(const QNetworkRequest &request, Operation operation, QNetworkReply *reply, qint64 started);
 	void updateOptions(const QUrl &url);
 	void setFormRequest(const QUrl &url);
 	void setWidget(QtWebKitWebWidget *widget);
@@ -55,6 +83,8 @@ protected slots:
 	void handleProxyAuthenticationRequired(const QNetworkProxy &proxy, QAuthenticator *authenticator);
 	void handleSslErrors(QNetworkReply *reply, const QList<QSslError> &errors);
 	void downloadProgress(qint64 bytesReceived, qint64 bytesTotal);
+	void handleReplyEncrypted();
+	void handleReplyMetaDataChanged();
 	void requestFinished(QNetworkReply *reply);
 
 private:
@@ -63,6 +93,9 @@ private:
 	QString m_acceptLanguage;
 	QUrl m_formRequestUrl;
 	QHash<QNetworkReply*, QPair<qint64, bool> > m_replies;
+	QHash<QNetworkReply*, int> m_timingReplies;
+	QVector<RequestTiming> m_timings;
+	QElapsedTimer m_timer;
 	qint64 m_speed;
 	qint64 m_bytesReceivedDifference;
 	qint64 m_bytesReceived;
@@ -72,6 +105,7 @@ private:
 	int m_updateTimer;
 	NetworkManagerFactory::DoNotTrackPolicy m_doNotTrackPolicy;
 	bool m_canSendReferrer;
+	bool m_isLoggingEnabled;
 
 signals:
 	void messageChanged(const QString &message = QString());
@@ -25,6 +25,7 @@
 #include "../../../../core/Console.h"
 #include "../../../../core/ContentBlockingManager.h"
 #include "../../../../core/NetworkManagerFactory.h"
+#include "../../../../core/PreconnectManager.h"
 #include "../../../../core/SettingsManager.h"
 #include "../../../../core/Utils.h"
 #include "../../../../core/WebBackendsManager.h"
@@ -60,7 +61,7 @@ QtWebKitPage::QtWebKitPage(QtWebKitNetworkManager *networkManager, QtWebKitWebWi
 
 	connect(this, SIGNAL(loadFinished(bool)), this, SLOT(pageLoadFinished()));
 	connect(ContentBlockingManager::getInstance(), SIGNAL(styleSheetsUpdated()), this, SLOT(updatePageStyleSheets()));
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString,QVariant)));
+	SettingsManager::addGroupListener(this, QLatin1String("Content/"));
 }
 
 QtWebKitPage::QtWebKitPage() : QWebPage(),
@@ -71,14 +72,12 @@ QtWebKitPage::QtWebKitPage() : QWebPage(),
 {
 }
 
-void QtWebKitPage::optionChanged(const QString &option, const QVariant &value)
+void QtWebKitPage::optionChanged(int identifier, const QVariant &value)
 {
+	Q_UNUSED(identifier)
 	Q_UNUSED(value)
 
-	if (option.startsWith(QLatin1String("Content/")))
-	{
-		updatePageStyleSheets();
-	}
+	updatePageStyleSheets();
 }
 
 void QtWebKitPage::pageLoadFinished()
@@ -314,6 +313,11 @@ bool QtWebKitPage::acceptNavigationRequest(QWebFrame *frame, const QNetworkReque
 		}
 	}
 
+	if (frame && frame == mainFrame())
+	{
+		PreconnectManager::markRequested(request.url());
+	}
+
 	emit aboutToNavigate(frame, type);
 
 	return true;
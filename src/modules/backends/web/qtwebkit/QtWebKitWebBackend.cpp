@@ -24,7 +24,6 @@
 #include "QtWebKitWebWidget.h"
 #include "../../../../core/NetworkManagerFactory.h"
 #include "../../../../core/SettingsManager.h"
-#include "../../../../core/Utils.h"
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
@@ -64,15 +63,12 @@ QtWebKitWebBackend::QtWebKitWebBackend(QObject *parent) : WebBackend(parent),
 	page->deleteLater();
 }
 
-void QtWebKitWebBackend::optionChanged(const QString &option)
+void QtWebKitWebBackend::optionChanged(int identifier, const QVariant &value)
 {
-	if (option == QLatin1String("Cache/PagesInMemoryLimit"))
+	if (identifier == SettingsManager::Cache_PagesInMemoryLimitOption)
 	{
-		QWebSettings::setMaximumPagesInCache(SettingsManager::getValue(QLatin1String("Cache/PagesInMemoryLimit")).toInt());
-	}
+		QWebSettings::setMaximumPagesInCache(value.toInt());
 
-	if (!(option.startsWith(QLatin1String("Browser/")) || option.startsWith(QLatin1String("Content/"))))
-	{
 		return;
 	}
 
@@ -129,9 +125,11 @@ WebWidget* QtWebKitWebBackend::createWidget(bool isPrivate, ContentsWidget *pare
 
 		QWebSettings::setMaximumPagesInCache(SettingsManager::getValue(QLatin1String("Cache/PagesInMemoryLimit")).toInt());
 
-		optionChanged(QLatin1String("Browser/"));
+		optionChanged(-1, QVariant());
 
-		connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString)));
+		SettingsManager::addListener(this, QList<int>() << SettingsManager::Cache_PagesInMemoryLimitOption);
+		SettingsManager::addGroupListener(this, QLatin1String("Browser/"));
+		SettingsManager::addGroupListener(this, QLatin1String("Content/"));
 	}
 
 	return new QtWebKitWebWidget(isPrivate, this, NULL, parent);
@@ -184,11 +182,9 @@ QString QtWebKitWebBackend::getUserAgent(const QString &pattern) const
 	return ((userAgent.value.isEmpty()) ? QString() : getUserAgent(userAgent.value));
 }
 
-QIcon QtWebKitWebBackend::getIconForUrl(const QUrl &url)
+QIcon QtWebKitWebBackend::loadIconForUrl(const QUrl &url)
 {
-	const QIcon icon = QWebSettings::iconForUrl(url);
-
-	return (icon.isNull() ? Utils::getIcon(QLatin1String("text-html")) : icon);
+	return QWebSettings::iconForUrl(url);
 }
 
 }
@@ -34,11 +34,13 @@
 #include "../../../../core/NetworkCache.h"
 #include "../../../../core/NetworkManager.h"
 #include "../../../../core/NetworkManagerFactory.h"
+#include "../../../../core/PreconnectManager.h"
 #include "../../../../core/SearchesManager.h"
 #include "../../../../core/SessionsManager.h"
 #include "../../../../core/SettingsManager.h"
 #include "../../../../core/TransfersManager.h"
 #include "../../../../core/Utils.h"
+#include "../../../../core/WebBackend.h"
 #include "../../../../ui/ContentsDialog.h"
 #include "../../../../ui/ContentsWidget.h"
 #include "../../../../ui/MainWindow.h"
@@ -113,14 +115,14 @@ QtWebKitWebWidget::QtWebKitWebWidget(bool isPrivate, WebBackend *backend, QtWebK
 	m_webView->settings()->setAttribute(QWebSettings::PrivateBrowsingEnabled, isPrivate);
 	m_webView->installEventFilter(this);
 
-	optionChanged(QLatin1String("History/BrowsingLimitAmountWindow"), SettingsManager::getValue(QLatin1String("History/BrowsingLimitAmountWindow")));
-	optionChanged(QLatin1String("Browser/JavaScriptCanShowStatusMessages"), SettingsManager::getValue(QLatin1String("Browser/JavaScriptCanShowStatusMessages")));
-	optionChanged(QLatin1String("Content/BackgroundColor"), SettingsManager::getValue(QLatin1String("Content/BackgroundColor")));
+	optionChanged(SettingsManager::History_BrowsingLimitAmountWindowOption, SettingsManager::getValue(SettingsManager::History_BrowsingLimitAmountWindowOption));
+	optionChanged(SettingsManager::Browser_JavaScriptCanShowStatusMessagesOption, SettingsManager::getValue(SettingsManager::Browser_JavaScriptCanShowStatusMessagesOption));
+	optionChanged(SettingsManager::Content_BackgroundColorOption, SettingsManager::getValue(SettingsManager::Content_BackgroundColorOption));
 	updateEditActions();
 	setZoom(SettingsManager::getValue(QLatin1String("Content/DefaultZoom")).toInt());
 
 	connect(BookmarksManager::getInstance(), SIGNAL(modelModified()), this, SLOT(updateBookmarkActions()));
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString,QVariant)));
+	SettingsManager::addListener(this, QList<int>() << SettingsManager::History_BrowsingLimitAmountWindowOption << SettingsManager::Browser_JavaScriptCanShowStatusMessagesOption << SettingsManager::Content_BackgroundColorOption);
 	connect(m_page, SIGNAL(aboutToNavigate(QWebFrame*,QWebPage::NavigationType)), this, SLOT(navigating(QWebFrame*,QWebPage::NavigationType)));
 	connect(m_page, SIGNAL(requestedNewWindow(WebWidget*,OpenHints)), this, SIGNAL(requestedNewWindow(WebWidget*,OpenHints)));
 	connect(m_page, SIGNAL(saveFrameStateRequested(QWebFrame*,QWebHistoryItem*)), this, SLOT(saveState(QWebFrame*,QWebHistoryItem*)));
@@ -192,17 +194,17 @@ void QtWebKitWebWidget::print(QPrinter *printer)
 	m_webView->print(printer);
 }
 
-void QtWebKitWebWidget::optionChanged(const QString &option, const QVariant &value)
+void QtWebKitWebWidget::optionChanged(int identifier, const QVariant &value)
 {
-	if (option == QLatin1String("History/BrowsingLimitAmountWindow"))
+	if (identifier == SettingsManager::History_BrowsingLimitAmountWindowOption)
 	{
 		m_webView->page()->history()->setMaximumItemCount(value.toInt());
 	}
-	else if (option == QLatin1String("Browser/JavaScriptCanShowStatusMessages"))
+	else if (identifier == SettingsManager::Browser_JavaScriptCanShowStatusMessagesOption)
 	{
 		disconnect(m_webView->page(), SIGNAL(statusBarMessage(QString)), this, SLOT(setStatusMessage(QString)));
 
-		if (value.toBool() || SettingsManager::getValue(option, getUrl()).toBool())
+		if (value.toBool() || SettingsManager::getValue(SettingsManager::getOptionName(identifier), getUrl()).toBool())
 		{
 			connect(m_webView->page(), SIGNAL(statusBarMessage(QString)), this, SLOT(setStatusMessage(QString)));
 		}
@@ -211,7 +213,7 @@ void QtWebKitWebWidget::optionChanged(const QString &option, const QVariant &val
 			setStatusMessage(QString());
 		}
 	}
-	else if (option == QLatin1String("Content/BackgroundColor"))
+	else if (identifier == SettingsManager::Content_BackgroundColorOption)
 	{
 		QPalette palette = m_page->palette();
 		palette.setColor(QPalette::Base, QColor(value.toString()));
@@ -389,6 +391,11 @@ void QtWebKitWebWidget::hideInspector()
 void QtWebKitWebWidget::linkHovered(const QString &link)
 {
 	setStatusMessage(link, true);
+
+	if (!link.isEmpty() && !isPrivate())
+	{
+		PreconnectManager::prefetchHost(QUrl(link));
+	}
 }
 
 void QtWebKitWebWidget::clearPluginToken()
@@ -456,12 +463,12 @@ void QtWebKitWebWidget::notifyUrlChanged(const QUrl &url)
 	updateNavigationActions();
 
 	emit urlChanged(url);
-
-	SessionsManager::markSessionModified();
 }
 
 void QtWebKitWebWidget::notifyIconChanged()
 {
+	getBackend()->markIconChanged(getUrl());
+
 	emit iconChanged(getIcon());
 }
 
@@ -775,20 +782,21 @@ void QtWebKitWebWidget::updateBookmarkActions()
 
 void QtWebKitWebWidget::updateOptions(const QUrl &url)
 {
+	const QVariantHash overrides = SettingsManager::getOverrides(url.isEmpty() ? getUrl() : url);
 	QWebSettings *settings = m_webView->page()->settings();
-	settings->setAttribute(QWebSettings::AutoLoadImages, getOption(QLatin1String("Browser/EnableImages"), url).toBool());
-	settings->setAttribute(QWebSettings::PluginsEnabled, getOption(QLatin1String("Browser/EnablePlugins"), url).toString() != QLatin1String("disabled"));
-	settings->setAttribute(QWebSettings::JavaEnabled, getOption(QLatin1String("Browser/EnableJava"), url).toBool());
-	settings->setAttribute(QWebSettings::JavascriptEnabled, getOption(QLatin1String("Browser/EnableJavaScript"), url).toBool());
-	settings->setAttribute(QWebSettings::JavascriptCanAccessClipboard, getOption(QLatin1String("Browser/JavaScriptCanAccessClipboard"), url).toBool());
-	settings->setAttribute(QWebSettings::JavascriptCanCloseWindows, getOption(QLatin1String("Browser/JavaScriptCanCloseWindows"), url).toBool());
-	settings->setAttribute(QWebSettings::JavascriptCanOpenWindows, getOption(QLatin1String("Browser/JavaScriptCanOpenWindows"), url).toBool());
-	settings->setAttribute(QWebSettings::LocalStorageEnabled, getOption(QLatin1String("Browser/EnableLocalStorage"), url).toBool());
-	settings->setAttribute(QWebSettings::OfflineStorageDatabaseEnabled, getOption(QLatin1String("Browser/EnableOfflineStorageDatabase"), url).toBool());
-	settings->setAttribute(QWebSettings::OfflineWebApplicationCacheEnabled, getOption(QLatin1String("Browser/EnableOfflineWebApplicationCache"), url).toBool());
-	settings->setDefaultTextEncoding(getOption(QLatin1String("Content/DefaultCharacterEncoding"), url).toString());
-
-	const QString thirdPartyCookiesPolicy = SettingsManager::getValue(QLatin1String("Network/ThirdPartyCookiesPolicy"), url).toString();
+	settings->setAttribute(QWebSettings::AutoLoadImages, getOption(QLatin1String("Browser/EnableImages"), overrides).toBool());
+	settings->setAttribute(QWebSettings::PluginsEnabled, getOption(QLatin1String("Browser/EnablePlugins"), overrides).toString() != QLatin1String("disabled"));
+	settings->setAttribute(QWebSettings::JavaEnabled, getOption(QLatin1String("Browser/EnableJava"), overrides).toBool());
+	settings->setAttribute(QWebSettings::JavascriptEnabled, getOption(QLatin1String("Browser/EnableJavaScript"), overrides).toBool());
+	settings->setAttribute(QWebSettings::JavascriptCanAccessClipboard, getOption(QLatin1String("Browser/JavaScriptCanAccessClipboard"), overrides).toBool());
+	settings->setAttribute(QWebSettings::JavascriptCanCloseWindows, getOption(QLatin1String("Browser/JavaScriptCanCloseWindows"), overrides).toBool());
+	settings->setAttribute(QWebSettings::JavascriptCanOpenWindows, getOption(QLatin1String("Browser/JavaScriptCanOpenWindows"), overrides).toBool());
+	settings->setAttribute(QWebSettings::LocalStorageEnabled, getOption(QLatin1String("Browser/EnableLocalStorage"), overrides).toBool());
+	settings->setAttribute(QWebSettings::OfflineStorageDatabaseEnabled, getOption(QLatin1String("Browser/EnableOfflineStorageDatabase"), overrides).toBool());
+	settings->setAttribute(QWebSettings::OfflineWebApplicationCacheEnabled, getOption(QLatin1String("Browser/EnableOfflineWebApplicationCache"), overrides).toBool());
+	settings->setDefaultTextEncoding(getOption(QLatin1String("Content/DefaultCharacterEncoding"), overrides).toString());
+
+	const QString thirdPartyCookiesPolicy = getOption(QLatin1String("Network/ThirdPartyCookiesPolicy"), overrides).toString();
 
 	if (thirdPartyCookiesPolicy == QLatin1String("acceptExisting"))
 	{
@@ -805,7 +813,7 @@ void QtWebKitWebWidget::updateOptions(const QUrl &url)
 
 	disconnect(m_webView->page(), SIGNAL(statusBarMessage(QString)), this, SLOT(setStatusMessage(QString)));
 
-	if (getOption(QLatin1String("Browser/JavaScriptCanShowStatusMessages"), url).toBool())
+	if (getOption(QLatin1String("Browser/JavaScriptCanShowStatusMessages"), overrides).toBool())
 	{
 		connect(m_webView->page(), SIGNAL(statusBarMessage(QString)), this, SLOT(setStatusMessage(QString)));
 	}
@@ -818,7 +826,7 @@ void QtWebKitWebWidget::updateOptions(const QUrl &url)
 
 	m_networkManager->updateOptions(url);
 
-	m_canLoadPlugins = (getOption(QLatin1String("Browser/EnablePlugins"), url).toString() == QLatin1String("enabled"));
+	m_canLoadPlugins = (getOption(QLatin1String("Browser/EnablePlugins"), overrides).toString() == QLatin1String("enabled"));
 }
 
 void QtWebKitWebWidget::clearOptions()
@@ -1483,6 +1491,24 @@ void QtWebKitWebWidget::triggerAction(int identifier, bool checked)
 
 			m_webView->triggerPageAction(QWebPage::InspectElement);
 
+			break;
+		case Action::ExportNetworkLogAction:
+			{
+				const QString path = TransfersManager::getSavePath(QLatin1String("network.har"));
+
+				if (path.isEmpty())
+				{
+					break;
+				}
+
+				QFile file(path);
+
+				if (!file.open(QIODevice::WriteOnly) || file.write(m_networkManager->getNetworkLog()) < 0)
+				{
+					Console::addMessage(tr("Failed to save network log %0: %1").arg(path).arg(file.errorString()), OtherMessageCategory, ErrorMessageLevel);
+				}
+			}
+
 			break;
 		case Action::WebsitePreferencesAction:
 			{
@@ -1621,7 +1647,6 @@ void QtWebKitWebWidget::handleHistory()
 
 		m_page->history()->currentItem().setUserData(data);
 
-		SessionsManager::markSessionModified();
 		BookmarksManager::updateVisits(url.toString());
 	}
 	else if (identifier > 0)
@@ -1691,8 +1716,6 @@ void QtWebKitWebWidget::setZoom(int zoom)
 	{
 		m_webView->setZoomFactor(qBound(0.1, ((qreal) zoom / 100), (qreal) 100));
 
-		SessionsManager::markSessionModified();
-
 		emit zoomChanged(zoom);
 		emit progressBarGeometryChanged();
 	}
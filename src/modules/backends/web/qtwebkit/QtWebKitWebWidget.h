@@ -103,7 +103,7 @@ protected:
 	bool isScrollBar(const QPoint &position) const;
 
 protected slots:
-	void optionChanged(const QString &option, const QVariant &value);
+	void optionChanged(int identifier, const QVariant &value);
 	void navigating(QWebFrame *frame, QWebPage::NavigationType type);
 	void pageLoadStarted();
 	void pageLoadFinished();
@@ -209,45 +209,27 @@ void CacheContentsWidget::addEntry(const QUrl &entry)
 		}
 	}
 
-	NetworkCache *cache = NetworkManagerFactory::getCache();
-	QIODevice *device = cache->data(entry);
-	const QNetworkCacheMetaData metaData = cache->metaData(entry);
-	const QList<QPair<QByteArray, QByteArray> > headers = metaData.rawHeaders();
-	QString type;
-
-	for (int i = 0; i < headers.count(); ++i)
-	{
-		if (headers.at(i).first == QStringLiteral("Content-Type").toLatin1())
-		{
-			type = QString(headers.at(i).second);
-
-			break;
-		}
-	}
-
-	const QMimeType mimeType = ((type.isEmpty() && device) ? QMimeDatabase().mimeTypeForData(device) : QMimeDatabase().mimeTypeForName(type));
+	const NetworkCache::CacheEntry cacheEntry = NetworkManagerFactory::getCache()->getEntry(entry);
+	const QString type = cacheEntry.contentType.section(QLatin1Char(';'), 0, 0).trimmed();
+	const QMimeType mimeType = (type.isEmpty() ? QMimeDatabase().mimeTypeForUrl(entry) : QMimeDatabase().mimeTypeForName(type));
+	const qint64 size = ((cacheEntry.decodedSize > 0) ? cacheEntry.decodedSize : cacheEntry.size);
 	QList<QStandardItem*> entryItems;
 	entryItems.append(new QStandardItem(entry.path()));
 	entryItems.append(new QStandardItem(mimeType.name()));
-	entryItems.append(new QStandardItem(device ? Utils::formatUnit(device->size()) : QString()));
-	entryItems.append(new QStandardItem(metaData.lastModified().toString()));
-	entryItems.append(new QStandardItem(metaData.expirationDate().toString()));
+	entryItems.append(new QStandardItem((size > 0) ? Utils::formatUnit(size) : QString()));
+	entryItems.append(new QStandardItem(cacheEntry.lastModified.toString()));
+	entryItems.append(new QStandardItem(cacheEntry.expirationDate.toString()));
 	entryItems[0]->setData(entry, Qt::UserRole);
-	entryItems[2]->setData((device ? device->size() : 0), Qt::UserRole);
+	entryItems[2]->setData(size, Qt::UserRole);
 
 	QStandardItem *sizeItem = m_model->item(domainItem->row(), 2);
 
-	if (sizeItem && device)
+	if (sizeItem && size > 0)
 	{
-		sizeItem->setData((sizeItem->data(Qt::UserRole).toLongLong() + device->size()), Qt::UserRole);
+		sizeItem->setData((sizeItem->data(Qt::UserRole).toLongLong() + size), Qt::UserRole);
 		sizeItem->setText(Utils::formatUnit(sizeItem->data(Qt::UserRole).toLongLong()));
 	}
 
-	if (device)
-	{
-		device->deleteLater();
-	}
-
 	domainItem->appendRow(entryItems);
 	domainItem->setText(QStringLiteral("%1 (%2)").arg(domain).arg(domainItem->rowCount()));
 
@@ -415,7 +397,7 @@ void CacheContentsWidget::updateActions()
 	if (entry.isValid())
 	{
 		NetworkCache *cache = NetworkManagerFactory::getCache();
-		QIODevice *device = cache->data(entry);
+		QIODevice *device = cache->getEntryData(entry);
 		const QNetworkCacheMetaData metaData = cache->metaData(entry);
 		const QList<QPair<QByteArray, QByteArray> > headers = metaData.rawHeaders();
 		QString type;
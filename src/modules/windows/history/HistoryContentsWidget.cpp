@@ -21,6 +21,8 @@
 #include "../../../core/ActionsManager.h"
 #include "../../../core/HistoryManager.h"
 #include "../../../core/Utils.h"
+#include "../../../core/WebBackend.h"
+#include "../../../core/WebBackendsManager.h"
 #include "../../../ui/ItemDelegate.h"
 
 #include "ui_HistoryContentsWidget.h"
@@ -221,7 +223,7 @@ void HistoryContentsWidget::addEntry(const HistoryEntry &entry)
 	}
 
 	QList<QStandardItem*> entryItems;
-	entryItems.append(new QStandardItem((entry.icon.isNull() ? Utils::getIcon(QLatin1String("text-html")) : entry.icon), entry.url.toString().replace(QLatin1String("%23"), QString(QLatin1Char('#')))));
+	entryItems.append(new QStandardItem((entry.icon.isNull() ? WebBackendsManager::getBackend()->getIconForUrl(entry.url) : entry.icon), entry.url.toString().replace(QLatin1String("%23"), QString(QLatin1Char('#')))));
 	entryItems.append(new QStandardItem(entry.title.isEmpty() ? tr("(Untitled)") : entry.title));
 	entryItems.append(new QStandardItem(entry.time.toString()));
 	entryItems[0]->setData(entry.identifier, Qt::UserRole);
@@ -254,7 +256,7 @@ void HistoryContentsWidget::updateEntry(qint64 entry)
 
 	HistoryEntry historyEntry = HistoryManager::getEntry(entry);
 
-	entryItem->setIcon(historyEntry.icon.isNull() ? Utils::getIcon(QLatin1String("text-html")) : historyEntry.icon);
+	entryItem->setIcon(historyEntry.icon.isNull() ? WebBackendsManager::getBackend()->getIconForUrl(historyEntry.url) : historyEntry.icon);
 	entryItem->setText(historyEntry.url.toString());
 	entryItem->parent()->child(entryItem->row(), 1)->setText(historyEntry.title.isEmpty() ? tr("(Untitled)") : historyEntry.title);
 	entryItem->parent()->child(entryItem->row(), 2)->setText(historyEntry.time.toString());
@@ -59,10 +59,10 @@ WebContentsWidget::WebContentsWidget(bool isPrivate, WebWidget *widget, Window *
 	m_ui->findWidget->installEventFilter(this);
 	m_ui->verticalLayout->addWidget(m_webWidget);
 
-	optionChanged(QLatin1String("Browser/ShowDetailedProgressBar"), SettingsManager::getValue(QLatin1String("Browser/ShowDetailedProgressBar")));
-	optionChanged(QLatin1String("Search/EnableFindInPageAsYouType"), SettingsManager::getValue(QLatin1String("Search/EnableFindInPageAsYouType")));
+	optionChanged(SettingsManager::Browser_ShowDetailedProgressBarOption, SettingsManager::getValue(SettingsManager::Browser_ShowDetailedProgressBarOption));
+	optionChanged(SettingsManager::Search_EnableFindInPageAsYouTypeOption, SettingsManager::getValue(SettingsManager::Search_EnableFindInPageAsYouTypeOption));
 
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString,QVariant)));
+	SettingsManager::addListener(this, QList<int>() << SettingsManager::Browser_ShowDetailedProgressBarOption << SettingsManager::Search_EnableFindInPageAsYouTypeOption);
 	connect(m_ui->findLineEdit, SIGNAL(returnPressed()), this, SLOT(updateFind()));
 	connect(m_ui->caseSensitiveButton, SIGNAL(clicked()), this, SLOT(updateFind()));
 	connect(m_ui->highlightButton, SIGNAL(clicked()), this, SLOT(updateFindHighlight()));
@@ -158,9 +158,9 @@ void WebContentsWidget::resizeEvent(QResizeEvent *event)
 	ContentsWidget::resizeEvent(event);
 }
 
-void WebContentsWidget::optionChanged(const QString &option, const QVariant &value)
+void WebContentsWidget::optionChanged(int identifier, const QVariant &value)
 {
-	if (option == QLatin1String("Browser/ShowDetailedProgressBar"))
+	if (identifier == SettingsManager::Browser_ShowDetailedProgressBarOption)
 	{
 		m_isProgressBarEnabled = value.toBool();
 
@@ -179,7 +179,7 @@ void WebContentsWidget::optionChanged(const QString &option, const QVariant &val
 			disconnect(m_webWidget, SIGNAL(progressBarGeometryChanged()), this, SLOT(updateProgressBarWidget()));
 		}
 	}
-	else if (option == QLatin1String("Search/EnableFindInPageAsYouType"))
+	else if (identifier == SettingsManager::Search_EnableFindInPageAsYouTypeOption)
 	{
 		if (value.toBool())
 		{
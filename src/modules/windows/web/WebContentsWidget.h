@@ -76,7 +76,7 @@ protected:
 	void resizeEvent(QResizeEvent *event);
 
 protected slots:
-	void optionChanged(const QString &option, const QVariant &value);
+	void optionChanged(int identifier, const QVariant &value);
 	void scheduleGeometryUpdate();
 	void notifyRequestedOpenUrl(const QUrl &url, OpenHints hints);
 	void notifyRequestedNewWindow(WebWidget *widget, OpenHints hints);
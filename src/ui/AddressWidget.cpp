@@ -27,6 +27,7 @@
 #include "../core/BookmarksManager.h"
 #include "../core/BookmarksModel.h"
 #include "../core/InputInterpreter.h"
+#include "../core/PreconnectManager.h"
 #include "../core/SearchesManager.h"
 #include "../core/Utils.h"
 
@@ -53,6 +54,7 @@ AddressWidget::AddressWidget(Window *window, bool simpleMode, QWidget *parent) :
 	m_completer->setCompletionMode(QCompleter::InlineCompletion);
 	m_completer->setCompletionRole(Qt::DisplayRole);
 	m_completer->setFilterMode(Qt::MatchStartsWith);
+	m_completer->setModelSorting(QCompleter::CaseInsensitivelySortedModel);
 
 	setWindow(window);
 	setCompleter(m_completer);
@@ -60,12 +62,12 @@ AddressWidget::AddressWidget(Window *window, bool simpleMode, QWidget *parent) :
 
 	if (!m_simpleMode)
 	{
-		optionChanged(QLatin1String("AddressField/ShowBookmarkIcon"), SettingsManager::getValue(QLatin1String("AddressField/ShowBookmarkIcon")));
-		optionChanged(QLatin1String("AddressField/ShowUrlIcon"), SettingsManager::getValue(QLatin1String("AddressField/ShowUrlIcon")));
+		optionChanged(SettingsManager::AddressField_ShowBookmarkIconOption, SettingsManager::getValue(SettingsManager::AddressField_ShowBookmarkIconOption));
+		optionChanged(SettingsManager::AddressField_ShowUrlIconOption, SettingsManager::getValue(SettingsManager::AddressField_ShowUrlIconOption));
 		setPlaceholderText(tr("Enter address or search..."));
 		setMouseTracking(true);
 
-		connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString,QVariant)));
+		SettingsManager::addListener(this, QList<int>() << SettingsManager::AddressField_ShowBookmarkIconOption << SettingsManager::AddressField_ShowUrlIconOption << SettingsManager::AddressField_ShowLoadPluginsIconOption);
 	}
 
 	connect(this, SIGNAL(textChanged(QString)), this, SLOT(setCompletion(QString)));
@@ -243,9 +245,9 @@ void AddressWidget::mouseDoubleClickEvent(QMouseEvent *event)
 	}
 }
 
-void AddressWidget::optionChanged(const QString &option, const QVariant &value)
+void AddressWidget::optionChanged(int identifier, const QVariant &value)
 {
-	if (option == QLatin1String("AddressField/ShowBookmarkIcon"))
+	if (identifier == SettingsManager::AddressField_ShowBookmarkIconOption)
 	{
 		if (value.toBool() && !m_bookmarkLabel)
 		{
@@ -268,7 +270,7 @@ void AddressWidget::optionChanged(const QString &option, const QVariant &value)
 			updateIcons();
 		}
 	}
-	else if (option == QLatin1String("AddressField/ShowUrlIcon"))
+	else if (identifier == SettingsManager::AddressField_ShowUrlIconOption)
 	{
 		if (value.toBool() && !m_urlIconLabel)
 		{
@@ -313,7 +315,7 @@ void AddressWidget::optionChanged(const QString &option, const QVariant &value)
 			}
 		}
 	}
-	else if (option == QLatin1String("AddressField/ShowLoadPluginsIcon") && m_window)
+	else if (identifier == SettingsManager::AddressField_ShowLoadPluginsIconOption && m_window)
 	{
 		if (value.toBool())
 		{
@@ -426,6 +428,16 @@ void AddressWidget::updateIcons()
 void AddressWidget::setCompletion(const QString &text)
 {
 	m_completer->setCompletionPrefix(text);
+
+	if (!hasFocus() || (m_window && m_window->isPrivate()))
+	{
+		return;
+	}
+
+	if (!m_completer->currentCompletion().isEmpty())
+	{
+		PreconnectManager::preconnect(m_completer->currentIndex().data(Qt::UserRole).toUrl());
+	}
 }
 
 void AddressWidget::setIcon(const QIcon &icon)
@@ -58,7 +58,7 @@ protected:
 	void mouseDoubleClickEvent(QMouseEvent *event);
 
 protected slots:
-	void optionChanged(const QString &option, const QVariant &value);
+	void optionChanged(int identifier, const QVariant &value);
 	void removeIcon();
 	void updateBookmark();
 	void updateLoadPlugins();
@@ -105,11 +105,12 @@ MainWindow::MainWindow(bool isPrivate, const SessionMainWindow &session, QWidget
 		createMenuBar();
 	}
 
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString,QVariant)));
+	SettingsManager::addListener(this, QList<int>() << SettingsManager::Interface_LockToolBarsOption << SettingsManager::Interface_ShowMenuBarOption << SettingsManager::Network_WorkOfflineOption);
 	connect(TransfersManager::getInstance(), SIGNAL(transferStarted(TransferInformation*)), this, SLOT(transferStarted()));
 	connect(m_windowsManager, SIGNAL(requestedAddBookmark(QUrl,QString)), this, SLOT(addBookmark(QUrl,QString)));
 	connect(m_windowsManager, SIGNAL(requestedNewWindow(bool,bool,QUrl)), this, SIGNAL(requestedNewWindow(bool,bool,QUrl)));
 	connect(m_windowsManager, SIGNAL(windowTitleChanged(QString)), this, SLOT(updateWindowTitle(QString)));
+	connect(SessionsManager::getInstance(), SIGNAL(restoreProgressChanged(int,int)), this, SLOT(updateRestoreProgress(int,int)));
 	connect(m_ui->consoleDockWidget, SIGNAL(visibilityChanged(bool)), m_actionsManager->getAction(Action::ShowErrorConsoleAction), SLOT(setChecked(bool)));
 	connect(m_ui->sidebarDockWidget, SIGNAL(visibilityChanged(bool)), m_actionsManager->getAction(Action::ShowSidebarAction), SLOT(setChecked(bool)));
 	connect(m_ui->sidebarDockWidget, SIGNAL(dockLocationChanged(Qt::DockWidgetArea)), m_ui->sidebarWidget, SLOT(locationChanged(Qt::DockWidgetArea)));
@@ -180,13 +181,13 @@ void MainWindow::closeEvent(QCloseEvent *event)
 	event->accept();
 }
 
-void MainWindow::optionChanged(const QString &option, const QVariant &value)
+void MainWindow::optionChanged(int identifier, const QVariant &value)
 {
-	if (option == QLatin1String("Network/WorkOffline"))
+	if (identifier == SettingsManager::Network_WorkOfflineOption)
 	{
 		m_actionsManager->getAction(Action::WorkOfflineAction)->setChecked(value.toBool());
 	}
-	else if (option == QLatin1String("Interface/LockToolBars"))
+	else if (identifier == SettingsManager::Interface_LockToolBarsOption)
 	{
 		const QList<QToolBar*> toolBars = findChildren<QToolBar*>();
 		const bool movable = !value.toBool();
@@ -198,7 +199,7 @@ void MainWindow::optionChanged(const QString &option, const QVariant &value)
 
 		m_actionsManager->getAction(Action::LockToolBarsAction)->setChecked(value.toBool());
 	}
-	else if (option == QLatin1String("Interface/ShowMenuBar"))
+	else if (identifier == SettingsManager::Interface_ShowMenuBarOption)
 	{
 		m_actionsManager->getAction(Action::ShowMenuBarAction)->setChecked(value.toBool());
 	}
@@ -539,6 +540,18 @@ void MainWindow::updateWindowTitle(const QString &title)
 	setWindowTitle(title.isEmpty() ? QStringLiteral("Otter") : QStringLiteral("%1 - Otter").arg(title));
 }
 
+void MainWindow::updateRestoreProgress(int restored, int total)
+{
+	if (restored < total)
+	{
+		m_ui->statusBar->showMessage(tr("Restoring tabs: %1 of %2").arg(restored).arg(total));
+	}
+	else
+	{
+		m_ui->statusBar->clearMessage();
+	}
+}
+
 MainWindow* MainWindow::findMainWindow(QObject *parent)
 {
 	MainWindow *window = NULL;
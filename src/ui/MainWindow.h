@@ -69,10 +69,11 @@ protected:
 	bool event(QEvent *event);
 
 protected slots:
-	void optionChanged(const QString &option, const QVariant &value);
+	void optionChanged(int identifier, const QVariant &value);
 	void addBookmark(const QUrl &url = QUrl(), const QString &title = QString(), bool warn = false);
 	void transferStarted();
 	void updateWindowTitle(const QString &title);
+	void updateRestoreProgress(int restored, int total);
 
 private:
 	ActionsManager *m_actionsManager;
@@ -33,6 +33,8 @@
 #include <QtCore/QJsonArray>
 #include <QtCore/QTextCodec>
 #include <QtGui/QMouseEvent>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QDesktopWidget>
 
 namespace Otter
 {
@@ -59,6 +61,26 @@ void Menu::changeEvent(QEvent *event)
 	}
 }
 
+void Menu::paintEvent(QPaintEvent *event)
+{
+	if (m_role == BookmarksMenuRole && !m_pendingIconActions.isEmpty())
+	{
+		const QList<QAction*> menuActions = actions();
+
+		for (int i = 0; i < menuActions.count(); ++i)
+		{
+			if (m_pendingIconActions.contains(menuActions.at(i)) && event->rect().intersects(actionGeometry(menuActions.at(i))))
+			{
+				QMetaObject::invokeMethod(this, "updateBookmarkIcons", Qt::QueuedConnection);
+
+				break;
+			}
+		}
+	}
+
+	QMenu::paintEvent(event);
+}
+
 void Menu::mouseReleaseEvent(QMouseEvent *event)
 {
 	if (m_role == BookmarksMenuRole && (event->button() == Qt::LeftButton || event->button() == Qt::MiddleButton))
@@ -94,6 +116,18 @@ void Menu::mouseReleaseEvent(QMouseEvent *event)
 	QMenu::mouseReleaseEvent(event);
 }
 
+void Menu::updateBookmarkAction(QAction *action, QStandardItem *item)
+{
+	if (!action || !item)
+	{
+		return;
+	}
+
+	m_pendingIconActions.insert(action);
+	action->setText(item->data(BookmarksModel::TitleRole).toString().isEmpty() ? tr("(Untitled)") : Utils::elideText(QString(item->data(BookmarksModel::TitleRole).toString()).replace(QLatin1Char('&'), QLatin1String("&&")), this));
+	action->setToolTip(item->data(BookmarksModel::DescriptionRole).toString());
+}
+
 void Menu::contextMenuEvent(QContextMenuEvent *event)
 {
 	if (m_role == BookmarksMenuRole)
@@ -164,9 +198,9 @@ void Menu::load(const QJsonObject &definition)
 
 	if (identifier == QLatin1String("BookmarksMenu"))
 	{
-		setRole(BookmarksMenuRole);
+		m_bookmarksFolder = BookmarksManager::getModel()->getRootItem()->index();
 
-		connect(BookmarksManager::getInstance(), SIGNAL(modelModified()), this, SLOT(clearBookmarksMenu()));
+		setRole(BookmarksMenuRole);
 	}
 	else if (identifier == QLatin1String("CharacterEncodingMenu"))
 	{
@@ -200,6 +234,12 @@ void Menu::setRole(MenuRole role)
 			installEventFilter(this);
 
 			connect(this, SIGNAL(aboutToShow()), this, SLOT(populateBookmarksMenu()));
+			connect(this, SIGNAL(aboutToShow()), this, SLOT(updateBookmarkIcons()));
+			connect(BookmarksManager::getModel(), SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(updateBookmarksMenu(QModelIndex)));
+			connect(BookmarksManager::getModel(), SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SLOT(updateBookmarksMenu(QModelIndex)));
+			connect(BookmarksManager::getModel(), SIGNAL(dataChanged(QModelIndex,QModelIndex)), this, SLOT(updateBookmarks(QModelIndex,QModelIndex)));
+			connect(BookmarksManager::getModel(), SIGNAL(layoutChanged()), this, SLOT(clearBookmarksMenu()));
+			connect(BookmarksManager::getModel(), SIGNAL(modelReset()), this, SLOT(clearBookmarksMenu()));
 
 			break;
 
@@ -251,33 +291,26 @@ void Menu::setRole(MenuRole role)
 
 void Menu::populateBookmarksMenu()
 {
-	QMenu *menu = qobject_cast<QMenu*>(sender());
-
-	if (!menu || !menu->menuAction())
-	{
-		return;
-	}
-
-	const QModelIndex index = menu->menuAction()->data().toModelIndex();
+	const int offset = getBookmarksOffset();
 
-	if ((index.isValid() && !menu->actions().isEmpty()) || (!index.isValid() && menu->actions().count() != 3))
+	if (!m_bookmarksFolder.isValid() || actions().count() != offset)
 	{
 		return;
 	}
 
-	QStandardItem *branch = (index.isValid() ? BookmarksManager::getModel()->itemFromIndex(index) : BookmarksManager::getModel()->getRootItem());
+	QStandardItem *branch = BookmarksManager::getModel()->itemFromIndex(m_bookmarksFolder);
 
 	if (!branch)
 	{
 		return;
 	}
 
-	if (index.isValid() && branch->rowCount() > 1)
+	if (offset == 0 && branch->rowCount() > 1)
 	{
-		QAction *openAllAction = menu->addAction(Utils::getIcon(QLatin1String("document-open-folder")), tr("Open All"), this, SLOT(openBookmark()));
-		openAllAction->setData(index);
+		QAction *openAllAction = QMenu::addAction(Utils::getIcon(QLatin1String("document-open-folder")), tr("Open All"), this, SLOT(openBookmark()));
+		openAllAction->setData(QModelIndex(m_bookmarksFolder));
 
-		menu->addSeparator();
+		addSeparator();
 	}
 
 	for (int i = 0; i < branch->rowCount(); ++i)
@@ -293,9 +326,10 @@ void Menu::populateBookmarksMenu()
 
 		if (type == BookmarksItem::RootBookmark || type == BookmarksItem::FolderBookmark || type == BookmarksItem::UrlBookmark)
 		{
-			QAction *action = menu->addAction(item->data(Qt::DecorationRole).value<QIcon>(), (item->data(BookmarksModel::TitleRole).toString().isEmpty() ? tr("(Untitled)") : Utils::elideText(QString(item->data(BookmarksModel::TitleRole).toString()).replace(QLatin1Char('&'), QLatin1String("&&")), menu)));
+			QAction *action = QMenu::addAction(QString());
 			action->setData(item->index());
-			action->setToolTip(item->data(BookmarksModel::DescriptionRole).toString());
+
+			updateBookmarkAction(action, item);
 
 			if (type == BookmarksItem::UrlBookmark)
 			{
@@ -304,6 +338,7 @@ void Menu::populateBookmarksMenu()
 			else if (item->rowCount() > 0)
 			{
 				Menu *subMenu = new Menu(this);
+				subMenu->m_bookmarksFolder = item->index();
 				subMenu->setRole(BookmarksMenuRole);
 
 				action->setMenu(subMenu);
@@ -311,7 +346,7 @@ void Menu::populateBookmarksMenu()
 		}
 		else
 		{
-			menu->addSeparator();
+			addSeparator();
 		}
 	}
 }
@@ -400,11 +435,11 @@ void Menu::populateClosedWindowsMenu()
 
 	if (window)
 	{
-		const QList<SessionWindow> tabs = window->getWindowsManager()->getClosedWindows();
+		const QList<ClosedWindow> tabs = window->getWindowsManager()->getClosedWindows();
 
 		for (int i = 0; i < tabs.count(); ++i)
 		{
-			QMenu::addAction(backend->getIconForUrl(QUrl(tabs.at(i).getUrl())), Utils::elideText(tabs.at(i).getTitle(), this), this, SLOT(restoreClosedWindow()))->setData(i + 1);
+			QMenu::addAction(backend->getIconForUrl(QUrl(tabs.at(i).url)), Utils::elideText(tabs.at(i).title, this), this, SLOT(restoreClosedWindow()))->setData(i + 1);
 		}
 	}
 }
@@ -424,29 +459,20 @@ void Menu::populateSessionsMenu()
 	m_actionGroup = new QActionGroup(this);
 	m_actionGroup->setExclusive(true);
 
-	const QStringList sessions = SessionsManager::getSessions();
-	QMultiHash<QString, SessionInformation> information;
+	const QList<SessionSummary> sessions = SessionsManager::getSessionSummaries();
+	QMultiHash<QString, SessionSummary> information;
 
 	for (int i = 0; i < sessions.count(); ++i)
 	{
-		const SessionInformation session = SessionsManager::getSession(sessions.at(i));
-
-		information.insert((session.title.isEmpty() ? tr("(Untitled)") : session.title), session);
+		information.insert(sessions.at(i).title, sessions.at(i));
 	}
 
-	const QList<SessionInformation> sorted = information.values();
+	const QList<SessionSummary> sorted = information.values();
 	const QString currentSession = SessionsManager::getCurrentSession();
 
 	for (int i = 0; i < sorted.count(); ++i)
 	{
-		int windows = 0;
-
-		for (int j = 0; j < sorted.at(i).windows.count(); ++j)
-		{
-			windows += sorted.at(i).windows.at(j).windows.count();
-		}
-
-		QAction *action = QMenu::addAction(tr("%1 (%n tab(s))", "", windows).arg(sorted.at(i).title.isEmpty() ? tr("(Untitled)") : QString(sorted.at(i).title).replace(QLatin1Char('&'), QLatin1String("&&"))));
+		QAction *action = QMenu::addAction(tr("%1 (%n tab(s))", "", sorted.at(i).tabs).arg(sorted.at(i).title.isEmpty() ? tr("(Untitled)") : QString(sorted.at(i).title).replace(QLatin1Char('&'), QLatin1String("&&"))));
 		action->setData(sorted.at(i).path);
 		action->setCheckable(true);
 		action->setChecked(sorted.at(i).path == currentSession);
@@ -508,14 +534,23 @@ void Menu::populateUserAgentMenu()
 
 void Menu::clearBookmarksMenu()
 {
-	if (actions().count() > 3)
+	const int offset = getBookmarksOffset();
+
+	for (int i = (actions().count() - 1); i >= offset; --i)
 	{
-		for (int i = (actions().count() - 1); i > 2; --i)
+		QAction *action = actions().at(i);
+
+		if (action->menu())
 		{
-			actions().at(i)->deleteLater();
-			removeAction(actions().at(i));
+			action->menu()->deleteLater();
 		}
+
+		removeAction(action);
+
+		action->deleteLater();
 	}
+
+	m_pendingIconActions.clear();
 }
 
 void Menu::clearClosedWindows()
@@ -633,6 +668,81 @@ void Menu::selectUserAgent(QAction *action)
 	}
 }
 
+void Menu::updateBookmarks(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+	if (!m_bookmarksFolder.isValid() || topLeft.parent() != m_bookmarksFolder)
+	{
+		return;
+	}
+
+	const QList<QAction*> menuActions = actions();
+
+	for (int i = 0; i < menuActions.count(); ++i)
+	{
+		const QModelIndex index = menuActions.at(i)->data().toModelIndex();
+
+		if (index.isValid() && index.parent() == topLeft.parent() && index.row() >= topLeft.row() && index.row() <= bottomRight.row())
+		{
+			updateBookmarkAction(menuActions.at(i), BookmarksManager::getModel()->itemFromIndex(index));
+		}
+	}
+}
+
+void Menu::updateBookmarkIcons()
+{
+	if (m_pendingIconActions.isEmpty())
+	{
+		return;
+	}
+
+	const QRect area = (isVisible() ? rect() : QRect(QPoint(0, 0), QApplication::desktop()->availableGeometry(this).size()));
+	const QList<QAction*> menuActions = actions();
+
+	for (int i = 0; i < menuActions.count(); ++i)
+	{
+		QAction *action = menuActions.at(i);
+
+		if (m_pendingIconActions.contains(action) && area.intersects(actionGeometry(action)))
+		{
+			m_pendingIconActions.remove(action);
+
+			action->setIcon(action->data().toModelIndex().data(Qt::DecorationRole).value<QIcon>());
+		}
+	}
+}
+
+void Menu::updateBookmarksMenu(const QModelIndex &parent)
+{
+	if (!m_bookmarksFolder.isValid())
+	{
+		return;
+	}
+
+	if (parent == m_bookmarksFolder)
+	{
+		clearBookmarksMenu();
+
+		return;
+	}
+
+	if (parent.parent() != m_bookmarksFolder)
+	{
+		return;
+	}
+
+	const QList<QAction*> menuActions = actions();
+
+	for (int i = 0; i < menuActions.count(); ++i)
+	{
+		if (menuActions.at(i)->data().toModelIndex() == parent && (menuActions.at(i)->menu() == NULL) != (BookmarksManager::getModel()->rowCount(parent) == 0))
+		{
+			clearBookmarksMenu();
+
+			return;
+		}
+	}
+}
+
 void Menu::updateClosedWindowsMenu()
 {
 	MainWindow *window = MainWindow::findMainWindow(parent());
@@ -640,6 +750,11 @@ void Menu::updateClosedWindowsMenu()
 	setEnabled((window && window->getWindowsManager()->getClosedWindows().count() > 0) || SessionsManager::getClosedWindows().count() > 0);
 }
 
+int Menu::getBookmarksOffset() const
+{
+	return ((m_bookmarksFolder == BookmarksManager::getModel()->getRootItem()->index()) ? 3 : 0);
+}
+
 Action* Menu::addAction(int identifier)
 {
 	Action *action = new Action(identifier, this);
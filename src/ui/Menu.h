@@ -21,6 +21,9 @@
 #define OTTER_MENU_H
 
 #include <QtCore/QJsonObject>
+#include <QtCore/QPersistentModelIndex>
+#include <QtCore/QSet>
+#include <QtGui/QStandardItem>
 #include <QtWidgets/QMenu>
 
 namespace Otter
@@ -53,8 +56,11 @@ public:
 
 protected:
 	void changeEvent(QEvent *event);
+	void paintEvent(QPaintEvent *event);
 	void mouseReleaseEvent(QMouseEvent *event);
 	void contextMenuEvent(QContextMenuEvent *event);
+	void updateBookmarkAction(QAction *action, QStandardItem *item);
+	int getBookmarksOffset() const;
 
 protected slots:
 	void populateBookmarksMenu();
@@ -70,11 +76,16 @@ protected slots:
 	void openSession(QAction *action);
 	void selectCharacterEncoding(QAction *action);
 	void selectUserAgent(QAction *action);
+	void updateBookmarks(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+	void updateBookmarkIcons();
+	void updateBookmarksMenu(const QModelIndex &parent);
 	void updateClosedWindowsMenu();
 
 private:
 	QActionGroup *m_actionGroup;
 	BookmarksItem *m_bookmark;
+	QPersistentModelIndex m_bookmarksFolder;
+	QSet<QAction*> m_pendingIconActions;
 	QString m_title;
 	MenuRole m_role;
 };
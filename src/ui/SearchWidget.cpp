@@ -53,14 +53,14 @@ SearchWidget::SearchWidget(QWidget *parent) : QComboBox(parent),
 	setModel(SearchesManager::getSearchEnginesModel());
 	setInsertPolicy(QComboBox::NoInsert);
 	setCurrentSearchEngine();
-	optionChanged(QLatin1String("Search/SearchEnginesSuggestions"), SettingsManager::getValue(QLatin1String("Search/SearchEnginesSuggestions")));
+	optionChanged(SettingsManager::Search_SearchEnginesSuggestionsOption, SettingsManager::getValue(SettingsManager::Search_SearchEnginesSuggestionsOption));
 
 	lineEdit()->setCompleter(m_completer);
 	lineEdit()->setStyleSheet(QLatin1String("QLineEdit {background:transparent;}"));
 
 	connect(SearchesManager::getInstance(), SIGNAL(searchEnginesModified()), this, SLOT(storeCurrentSearchEngine()));
 	connect(SearchesManager::getInstance(), SIGNAL(searchEnginesModelModified()), this, SLOT(restoreCurrentSearchEngine()));
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString,QVariant)));
+	SettingsManager::addListener(this, QList<int>() << SettingsManager::Search_SearchEnginesSuggestionsOption);
 	connect(this, SIGNAL(currentIndexChanged(int)), this, SLOT(currentSearchEngineChanged(int)));
 	connect(this, SIGNAL(activated(int)), this, SLOT(searchEngineSelected(int)));
 	connect(lineEdit(), SIGNAL(textChanged(QString)), this, SLOT(queryChanged(QString)));
@@ -201,9 +201,9 @@ void SearchWidget::hidePopup()
 	QComboBox::hidePopup();
 }
 
-void SearchWidget::optionChanged(const QString &option, const QVariant &value)
+void SearchWidget::optionChanged(int identifier, const QVariant &value)
 {
-	if (option == QLatin1String("Search/SearchEnginesSuggestions"))
+	if (identifier == SettingsManager::Search_SearchEnginesSuggestionsOption)
 	{
 		if (value.toBool() && !m_suggester)
 		{
@@ -55,7 +55,7 @@ protected:
 	bool setPlaceholderText(int index);
 
 protected slots:
-	void optionChanged(const QString &option, const QVariant &value);
+	void optionChanged(int identifier, const QVariant &value);
 	void currentSearchEngineChanged(int index);
 	void searchEngineSelected(int index);
 	void queryChanged(const QString &query);
@@ -34,17 +34,15 @@ SessionsManagerDialog::SessionsManagerDialog(QWidget *parent) : QDialog(parent),
 {
 	m_ui->setupUi(this);
 
-	const QStringList sessions = SessionsManager::getSessions();
-	QMultiHash<QString, SessionInformation> information;
+	const QList<SessionSummary> sessions = SessionsManager::getSessionSummaries();
+	QMultiHash<QString, SessionSummary> information;
 
 	for (int i = 0; i < sessions.count(); ++i)
 	{
-		const SessionInformation session = SessionsManager::getSession(sessions.at(i));
-
-		information.insert((session.title.isEmpty() ? tr("(Untitled)") : session.title), session);
+		information.insert(sessions.at(i).title, sessions.at(i));
 	}
 
-	const QList<SessionInformation> sorted = information.values();
+	const QList<SessionSummary> sorted = information.values();
 	const QString currentSession = SessionsManager::getCurrentSession();
 	int index = 0;
 
@@ -52,13 +50,6 @@ SessionsManagerDialog::SessionsManagerDialog(QWidget *parent) : QDialog(parent),
 
 	for (int i = 0; i < sorted.count(); ++i)
 	{
-		int windows = 0;
-
-		for (int j = 0; j < sorted.at(i).windows.count(); ++j)
-		{
-			windows += sorted.at(i).windows.at(j).windows.count();
-		}
-
 		if (sorted.at(i).path == currentSession)
 		{
 			index = i;
@@ -66,7 +57,7 @@ SessionsManagerDialog::SessionsManagerDialog(QWidget *parent) : QDialog(parent),
 
 		m_ui->sessionsWidget->setItem(i, 0, new QTableWidgetItem(sorted.at(i).title.isEmpty() ? tr("(Untitled)") : sorted.at(i).title));
 		m_ui->sessionsWidget->setItem(i, 1, new QTableWidgetItem(sorted.at(i).path));
-		m_ui->sessionsWidget->setItem(i, 2, new QTableWidgetItem(QStringLiteral("%1 (%2)").arg(sorted.at(i).windows.count()).arg(windows)));
+		m_ui->sessionsWidget->setItem(i, 2, new QTableWidgetItem(QStringLiteral("%1 (%2)").arg(sorted.at(i).windows).arg(sorted.at(i).tabs)));
 	}
 
 	connect(m_ui->openButton, SIGNAL(clicked()), this, SLOT(openSession()));
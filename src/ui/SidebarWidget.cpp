@@ -35,11 +35,11 @@ SidebarWidget::SidebarWidget(QWidget *parent) : QWidget(parent),
 {
 	m_ui->setupUi(this);
 
-	optionChanged(QLatin1String("Sidebar/CurrentPanel"), SettingsManager::getValue(QLatin1String("Sidebar/CurrentPanel")));
-	optionChanged(QLatin1String("Sidebar/Panels"), SettingsManager::getValue(QLatin1String("Sidebar/Panels")));
+	optionChanged(SettingsManager::Sidebar_CurrentPanelOption, SettingsManager::getValue(SettingsManager::Sidebar_CurrentPanelOption));
+	optionChanged(SettingsManager::Sidebar_PanelsOption, SettingsManager::getValue(SettingsManager::Sidebar_PanelsOption));
 	updateSize();
 
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString,QVariant)));
+	SettingsManager::addListener(this, QList<int>() << SettingsManager::Sidebar_CurrentPanelOption << SettingsManager::Sidebar_PanelsOption);
 }
 
 SidebarWidget::~SidebarWidget()
@@ -64,13 +64,13 @@ void SidebarWidget::showEvent(QShowEvent *event)
 	QWidget::showEvent(event);
 }
 
-void SidebarWidget::optionChanged(const QString &option, const QVariant &value)
+void SidebarWidget::optionChanged(int identifier, const QVariant &value)
 {
-	if (option == QLatin1String("Sidebar/CurrentPanel"))
+	if (identifier == SettingsManager::Sidebar_CurrentPanelOption)
 	{
 		openPanel(value.toString());
 	}
-	else if (option == QLatin1String("Sidebar/Panels"))
+	else if (identifier == SettingsManager::Sidebar_PanelsOption)
 	{
 		for (QHash<QString, QToolButton*>::const_iterator iterator = m_buttons.constBegin(); iterator != m_buttons.constEnd(); ++iterator)
 		{
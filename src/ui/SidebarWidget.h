@@ -55,7 +55,7 @@ protected:
 protected slots:
 	void openPanel();
 	void openUrl(const QUrl &url, OpenHints);
-	void optionChanged(const QString &option, const QVariant &value);
+	void optionChanged(int identifier, const QVariant &value);
 
 private:
 	QWidget *m_currentWidget;
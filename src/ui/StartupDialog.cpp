@@ -33,17 +33,15 @@ StartupDialog::StartupDialog(const QString &session, QWidget *parent) : QDialog(
 	m_ui->setupUi(this);
 	m_ui->windowsTreeView->setModel(m_windowsModel);
 
-	const QStringList sessions = SessionsManager::getSessions();
-	QMultiHash<QString, SessionInformation> information;
+	const QList<SessionSummary> sessions = SessionsManager::getSessionSummaries();
+	QMultiHash<QString, SessionSummary> information;
 
 	for (int i = 0; i < sessions.count(); ++i)
 	{
-		const SessionInformation session = SessionsManager::getSession(sessions.at(i));
-
-		information.insert((session.title.isEmpty() ? tr("(Untitled)") : session.title), session);
+		information.insert(sessions.at(i).title, sessions.at(i));
 	}
 
-	const QList<SessionInformation> sorted = information.values();
+	const QList<SessionSummary> sorted = information.values();
 
 	for (int i = 0; i < sorted.count(); ++i)
 	{
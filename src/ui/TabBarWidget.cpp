@@ -64,11 +64,11 @@ TabBarWidget::TabBarWidget(QWidget *parent) : QTabBar(parent),
 	m_closeButtonPosition = static_cast<QTabBar::ButtonPosition>(QApplication::style()->styleHint(QStyle::SH_TabBar_CloseButtonPosition));
 	m_iconButtonPosition = ((m_closeButtonPosition == QTabBar::RightSide) ? QTabBar::LeftSide : QTabBar::RightSide);
 
-	optionChanged(QLatin1String("TabBar/ShowCloseButton"), SettingsManager::getValue(QLatin1String("TabBar/ShowCloseButton")));
-	optionChanged(QLatin1String("TabBar/ShowUrlIcon"), SettingsManager::getValue(QLatin1String("TabBar/ShowUrlIcon")));
-	optionChanged(QLatin1String("TabBar/EnablePreviews"), SettingsManager::getValue(QLatin1String("TabBar/EnablePreviews")));
+	optionChanged(SettingsManager::TabBar_ShowCloseButtonOption, SettingsManager::getValue(SettingsManager::TabBar_ShowCloseButtonOption));
+	optionChanged(SettingsManager::TabBar_ShowUrlIconOption, SettingsManager::getValue(SettingsManager::TabBar_ShowUrlIconOption));
+	optionChanged(SettingsManager::TabBar_EnablePreviewsOption, SettingsManager::getValue(SettingsManager::TabBar_EnablePreviewsOption));
 
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString,QVariant)));
+	SettingsManager::addListener(this, QList<int>() << SettingsManager::TabBar_EnablePreviewsOption << SettingsManager::TabBar_ShowCloseButtonOption << SettingsManager::TabBar_ShowUrlIconOption);
 	connect(this, SIGNAL(currentChanged(int)), this, SLOT(currentTabChanged(int)));
 	connect(this, SIGNAL(tabCloseRequested(int)), this, SIGNAL(requestedClose(int)));
 }
@@ -464,13 +464,13 @@ void TabBarWidget::hidePreview()
 	}
 }
 
-void TabBarWidget::optionChanged(const QString &option, const QVariant &value)
+void TabBarWidget::optionChanged(int identifier, const QVariant &value)
 {
-	if (option == QLatin1String("TabBar/ShowCloseButton"))
+	if (identifier == SettingsManager::TabBar_ShowCloseButtonOption)
 	{
 		setTabsClosable(value.toBool());
 	}
-	else if (option == QLatin1String("TabBar/ShowUrlIcon"))
+	else if (identifier == SettingsManager::TabBar_ShowUrlIconOption)
 	{
 		if (m_showUrlIcon != value.toBool())
 		{
@@ -496,7 +496,7 @@ void TabBarWidget::optionChanged(const QString &option, const QVariant &value)
 
 		m_showUrlIcon = value.toBool();
 	}
-	else if (option == QLatin1String("TabBar/EnablePreviews"))
+	else if (identifier == SettingsManager::TabBar_EnablePreviewsOption)
 	{
 		m_enablePreviews = value.toBool();
 	}
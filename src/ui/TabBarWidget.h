@@ -67,7 +67,7 @@ protected:
 	QSize tabSizeHint(int index) const;
 
 protected slots:
-	void optionChanged(const QString &option, const QVariant &value);
+	void optionChanged(int identifier, const QVariant &value);
 	void currentTabChanged(int index);
 	void closeOtherTabs();
 	void cloneTab();
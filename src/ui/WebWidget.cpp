@@ -692,6 +692,18 @@ QVariant WebWidget::getOption(const QString &key, const QUrl &url) const
 	return SettingsManager::getValue(key, (url.isEmpty() ? getUrl() : url));
 }
 
+QVariant WebWidget::getOption(const QString &key, const QVariantHash &overrides) const
+{
+	if (m_options.contains(key))
+	{
+		return m_options[key];
+	}
+
+	const QVariantHash::const_iterator value = overrides.constFind(key);
+
+	return ((value == overrides.constEnd()) ? SettingsManager::getValue(key) : value.value());
+}
+
 QUrl WebWidget::getRequestedUrl() const
 {
 	return ((getUrl().isEmpty() || isLoading()) ? m_requestedUrl : getUrl());
@@ -132,6 +132,7 @@ protected:
 	void mouseMoveEvent(QMouseEvent *event);
 	void startReloadTimer();
 	virtual void setOptions(const QVariantHash &options);
+	QVariant getOption(const QString &key, const QVariantHash &overrides) const;
 
 protected slots:
 	void triggerAction();
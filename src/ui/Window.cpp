@@ -57,16 +57,12 @@ Window::Window(bool isPrivate, ContentsWidget *widget, QWidget *parent) : QWidge
 	m_addressWidget(NULL),
 	m_searchWidget(NULL),
 	m_contentsWidget(NULL),
+	m_lastActivity(QDateTime::currentDateTime()),
 	m_identifier(++m_identifierCounter),
 	m_areControlsHidden(false),
 	m_isPinned(false),
 	m_isPrivate(isPrivate)
 {
-	QBoxLayout *layout = new QBoxLayout(QBoxLayout::TopToBottom, this);
-	layout->setContentsMargins(0, 0, 0, 0);
-
-	setLayout(layout);
-
 	if (widget)
 	{
 		widget->setParent(this);
@@ -85,11 +81,18 @@ void Window::showEvent(QShowEvent *event)
 	}
 }
 
+void Window::hideEvent(QHideEvent *event)
+{
+	QWidget::hideEvent(event);
+
+	m_lastActivity = QDateTime::currentDateTime();
+}
+
 void Window::focusInEvent(QFocusEvent *event)
 {
 	QWidget::focusInEvent(event);
 
-	if (isUrlEmpty() && !m_contentsWidget->isLoading() && m_addressWidget)
+	if (m_contentsWidget && isUrlEmpty() && !m_contentsWidget->isLoading() && m_addressWidget)
 	{
 		m_addressWidget->setFocus();
 	}
@@ -270,22 +273,51 @@ void Window::notifyRequestedCloseWindow()
 	emit requestedCloseWindow(this);
 }
 
+void Window::notifySessionModified()
+{
+	SessionsManager::markSessionModified(this);
+}
+
 void Window::setSession(const SessionWindow &session)
 {
 	m_session = session;
 
 	setSearchEngine(session.searchEngine);
 	setPinned(session.pinned);
+}
+
+bool Window::hibernate()
+{
+	if (!m_contentsWidget || m_contentsWidget->getType() != QLatin1String("web") || m_contentsWidget->isLoading() || isVisible() || isPinned() || isPrivate())
+	{
+		return false;
+	}
+
+	m_session = getSession();
 
-	if (!SettingsManager::getValue(QLatin1String("Browser/DelayRestoringOfBackgroundTabs")).toBool())
+	layout()->removeWidget(m_contentsWidget);
+
+	m_contentsWidget->deleteLater();
+	m_contentsWidget = NULL;
+
+	if (m_navigationBar)
 	{
-		setUrl(session.getUrl(), false);
+		layout()->removeWidget(m_navigationBar);
+
+		m_navigationBar->deleteLater();
+		m_navigationBar = NULL;
+		m_addressWidget = NULL;
+		m_searchWidget = NULL;
 	}
+
+	emit loadingStateChanged(DelayedState);
+
+	return true;
 }
 
 void Window::setOption(const QString &key, const QVariant &value)
 {
-	if (m_contentsWidget->getType() == QLatin1String("web"))
+	if (m_contentsWidget && m_contentsWidget->getType() == QLatin1String("web"))
 	{
 		WebContentsWidget *webWidget = qobject_cast<WebContentsWidget*>(m_contentsWidget);
 
@@ -315,6 +347,10 @@ void Window::setSearchEngine(const QString &engine)
 	{
 		m_searchWidget->setCurrentSearchEngine(engine);
 	}
+	else
+	{
+		m_session.searchEngine = engine;
+	}
 }
 
 void Window::setUrl(const QUrl &url, bool typed)
@@ -408,6 +444,8 @@ void Window::setPinned(bool pinned)
 	{
 		m_isPinned = pinned;
 
+		SessionsManager::markSessionModified(this);
+
 		emit isPinnedChanged(pinned);
 	}
 }
@@ -428,6 +466,14 @@ void Window::setContentsWidget(ContentsWidget *widget)
 		return;
 	}
 
+	if (!layout())
+	{
+		QBoxLayout *layout = new QBoxLayout(QBoxLayout::TopToBottom, this);
+		layout->setContentsMargins(0, 0, 0, 0);
+
+		setLayout(layout);
+	}
+
 	if (m_contentsWidget->getType() == QLatin1String("web") && !m_navigationBar)
 	{
 		const ToolBarDefinition toolBar = ActionsManager::getToolBarDefinition(QLatin1String("NavigationBar"));
@@ -456,9 +502,15 @@ void Window::setContentsWidget(ContentsWidget *widget)
 			{
 				m_searchWidget = new SearchWidget(this);
 
+				if (!m_session.searchEngine.isEmpty())
+				{
+					m_searchWidget->setCurrentSearchEngine(m_session.searchEngine);
+				}
+
 				navigationLayout->addWidget(m_searchWidget);
 
 				connect(m_searchWidget, SIGNAL(requestedSearch(QString,QString,OpenHints)), this, SIGNAL(requestedSearch(QString,QString,OpenHints)));
+				connect(m_searchWidget, SIGNAL(currentIndexChanged(int)), this, SLOT(notifySessionModified()));
 			}
 			else if (toolBar.actions.at(i).action == QLatin1String("GoBackAction"))
 			{
@@ -556,6 +608,9 @@ void Window::setContentsWidget(ContentsWidget *widget)
 	connect(m_contentsWidget, SIGNAL(iconChanged(QIcon)), this, SIGNAL(iconChanged(QIcon)));
 	connect(m_contentsWidget, SIGNAL(loadingChanged(bool)), this, SLOT(notifyLoadingStateChanged(bool)));
 	connect(m_contentsWidget, SIGNAL(zoomChanged(int)), this, SIGNAL(zoomChanged(int)));
+	connect(m_contentsWidget, SIGNAL(urlChanged(QUrl)), this, SLOT(notifySessionModified()));
+	connect(m_contentsWidget, SIGNAL(loadingChanged(bool)), this, SLOT(notifySessionModified()));
+	connect(m_contentsWidget, SIGNAL(zoomChanged(int)), this, SLOT(notifySessionModified()));
 }
 
 Window* Window::clone(bool cloneHistory, QWidget *parent)
@@ -599,7 +654,7 @@ QVariant Window::getOption(const QString &key) const
 
 QString Window::getSearchEngine() const
 {
-	return (m_searchWidget ? m_searchWidget->getCurrentSearchEngine() : QString());
+	return (m_searchWidget ? m_searchWidget->getCurrentSearchEngine() : m_session.searchEngine);
 }
 
 QString Window::getTitle() const
@@ -670,11 +725,38 @@ WindowLoadingState Window::getLoadingState() const
 	return (m_contentsWidget ? (m_contentsWidget->isLoading() ? LoadingState : LoadedState) : DelayedState);
 }
 
+QDateTime Window::getLastActivity() const
+{
+	return (isVisible() ? QDateTime::currentDateTime() : m_lastActivity);
+}
+
 qint64 Window::getIdentifier() const
 {
 	return m_identifier;
 }
 
+qint64 Window::getEstimatedMemoryUsage() const
+{
+	if (!m_contentsWidget)
+	{
+		return 0;
+	}
+
+	qint64 usage = 10485760;
+
+	if (m_contentsWidget->getType() == QLatin1String("web"))
+	{
+		WebContentsWidget *webWidget = qobject_cast<WebContentsWidget*>(m_contentsWidget);
+
+		if (webWidget)
+		{
+			usage += webWidget->getWebWidget()->getStatistics().value(QLatin1String("bytesReceived"), 0).toLongLong();
+		}
+	}
+
+	return usage;
+}
+
 bool Window::canClone() const
 {
 	return (m_contentsWidget ? m_contentsWidget->canClone() : false);
@@ -23,6 +23,7 @@
 #include "../core/SessionsManager.h"
 #include "../core/WindowsManager.h"
 
+#include <QtCore/QDateTime>
 #include <QtCore/QUrl>
 #include <QtGui/QIcon>
 #include <QtPrintSupport/QPrinter>
@@ -62,6 +63,7 @@ public:
 	void clear();
 	void close();
 	void setSession(const SessionWindow &session);
+	bool hibernate();
 	Window* clone(bool cloneHistory = true, QWidget *parent = NULL);
 	ContentsWidget* getContentsWidget();
 	QVariant getOption(const QString &key) const;
@@ -74,7 +76,9 @@ public:
 	WindowHistoryInformation getHistory() const;
 	SessionWindow getSession() const;
 	WindowLoadingState getLoadingState() const;
+	QDateTime getLastActivity() const;
 	qint64 getIdentifier() const;
+	qint64 getEstimatedMemoryUsage() const;
 	bool canClone() const;
 	bool isPinned() const;
 	bool isPrivate() const;
@@ -91,6 +95,7 @@ public slots:
 
 protected:
 	void showEvent(QShowEvent *event);
+	void hideEvent(QHideEvent *event);
 	void focusInEvent(QFocusEvent *event);
 	void setContentsWidget(ContentsWidget *widget);
 
@@ -99,6 +104,7 @@ protected slots:
 	void handleSearchRequest(const QString &query, const QString &engine, OpenHints hints = DefaultOpen);
 	void notifyLoadingStateChanged(bool loading);
 	void notifyRequestedCloseWindow();
+	void notifySessionModified();
 
 private:
 	QWidget *m_navigationBar;
@@ -106,6 +112,7 @@ private:
 	SearchWidget *m_searchWidget;
 	ContentsWidget *m_contentsWidget;
 	SessionWindow m_session;
+	QDateTime m_lastActivity;
 	qint64 m_identifier;
 	bool m_areControlsHidden;
 	bool m_isPinned;
@@ -38,13 +38,13 @@ MenuActionWidget::MenuActionWidget(QWidget *parent) : ActionWidget(-1, NULL, par
 	setToolButtonStyle(Qt::ToolButtonTextBesideIcon);
 	setVisible(!SettingsManager::getValue(QLatin1String("Interface/ShowMenuBar")).toBool());
 
-	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(QString,QVariant)), this, SLOT(optionChanged(QString,QVariant)));
+	SettingsManager::addListener(this, QList<int>() << SettingsManager::Interface_ShowMenuBarOption);
 	connect(m_menu, SIGNAL(aboutToShow()), this, SLOT(updateMenu()));
 }
 
-void MenuActionWidget::optionChanged(const QString &option, const QVariant &value)
+void MenuActionWidget::optionChanged(int identifier, const QVariant &value)
 {
-	if (option == QLatin1String("Interface/ShowMenuBar"))
+	if (identifier == SettingsManager::Interface_ShowMenuBarOption)
 	{
 		setVisible(!value.toBool());
 	}
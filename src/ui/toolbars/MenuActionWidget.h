@@ -35,7 +35,7 @@ public:
 	explicit MenuActionWidget(QWidget *parent);
 
 protected slots:
-	void optionChanged(const QString &option, const QVariant &value);
+	void optionChanged(int identifier, const QVariant &value);
 	void updateMenu();
 
 private: